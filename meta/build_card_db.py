@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Compiles the KRCG card list (https://static.krcg.org/data/vtes.json) into the binary card
+# database read by src/client/card_database/card_database.cc.
+#
+# Usage: build_card_db.py <vtes.json> <cards.db>
+
+import json
+import struct
+import sys
+
+MAGIC = b"SNCD"
+FORMAT_VERSION = 2
+HEADER_FORMAT = "<4s7I"
+RANGE_FORMAT = "<4I"
+RECORD_FORMAT = "<8I2I2Q"
+
+# Must match Card::Type in src/client/models/card.h
+CARD_TYPES = {
+    "Vampire": 0x0001,
+    "Imbued": 0x0001,
+    "Master": 0x0002,
+    "Action": 0x0004,
+    "Action Modifier": 0x0008,
+    "Political Action": 0x0010,
+    "Equipment": 0x0020,
+    "Retainer": 0x0040,
+    "Ally": 0x0080,
+    "Combat": 0x0100,
+    "Reaction": 0x0200,
+    "Event": 0x0400,
+    "Power": 0x0800,
+    "Conviction": 0x1000,
+}
+
+# Must match DISCIPLINE_NAMES in src/client/models/card.cc; the bit of a discipline is its index
+DISCIPLINES = [
+    ("abo", "Abombwe"), ("ani", "Animalism"), ("aus", "Auspex"), ("cel", "Celerity"),
+    ("chi", "Chimerstry"), ("dai", "Daimoinon"), ("dem", "Dementation"), ("dom", "Dominate"),
+    ("fli", "Flight"), ("for", "Fortitude"), ("mel", "Melpominee"), ("myt", "Mytherceria"),
+    ("nec", "Necromancy"), ("obe", "Obeah"), ("obf", "Obfuscate"), ("obl", "Oblivion"),
+    ("obt", "Obtenebration"), ("pot", "Potence"), ("pre", "Presence"), ("pro", "Protean"),
+    ("qui", "Quietus"), ("san", "Sanguinus"), ("ser", "Serpentis"), ("spi", "Spiritus"),
+    ("str", "Striga"), ("tem", "Temporis"), ("tha", "Thaumaturgy"), ("thn", "Thanatosis"),
+    ("val", "Valeren"), ("vic", "Vicissitude"), ("vis", "Visceratika"), ("mal", "Maleficia"),
+    ("def", "Defense"), ("inn", "Innocence"), ("jud", "Judgment"), ("mar", "Martyrdom"),
+    ("red", "Redemption"), ("ven", "Vengeance"), ("vin", "Vision"),
+]
+DISCIPLINE_BITS = {}
+for index, (abbreviation, name) in enumerate(DISCIPLINES):
+    DISCIPLINE_BITS[abbreviation] = 1 << index
+    DISCIPLINE_BITS[name.lower()] = 1 << index
+
+# Card ids come in contiguous blocks (library 1xxxxx, crypt 2xxxxx); ids further apart start a new range
+RANGE_GAP = 1024
+
+
+def card_slug(card):
+    url = card.get("url", "")
+    if url:
+        return url.rsplit("/", 1)[-1].rsplit(".", 1)[0]
+    return "".join(c for c in card["name"].lower() if c.isalnum())
+
+
+def card_type(card):
+    mask = 0
+    for type_name in card.get("types", []):
+        mask |= CARD_TYPES.get(type_name, 0)
+    return mask
+
+
+def card_disciplines(card):
+    """Returns (any level, superior) masks; crypt cards list superior disciplines in upper case ("AUS")."""
+    disciplines = 0
+    superior = 0
+    for entry in card.get("disciplines", []):
+        # Library cards may require one of several disciplines ("dom/obf"); any of them counts
+        for part in entry.split("/"):
+            bit = DISCIPLINE_BITS.get(part.strip().lower(), 0)
+            disciplines |= bit
+            if "capacity" in card and part.isupper():
+                superior |= bit
+    return disciplines, superior
+
+
+def card_capacity(card):
+    try:
+        return max(0, int(card.get("capacity", 0)))
+    except (TypeError, ValueError):
+        # Some library cards list a variable capacity such as "X"
+        return 0
+
+
+class StringPool:
+    def __init__(self):
+        self.data = bytearray()
+        self.offsets = {}
+
+    def add(self, text):
+        encoded = text.encode("utf-8")
+        if encoded not in self.offsets:
+            self.offsets[encoded] = len(self.data)
+            self.data += encoded
+        return self.offsets[encoded], len(encoded)
+
+
+def build_ranges(ids):
+    ranges = []
+    for card_id in ids:
+        if ranges and card_id - ranges[-1][-1] <= RANGE_GAP:
+            ranges[-1].append(card_id)
+        else:
+            ranges.append([card_id])
+    return [(r[0], r[-1] - r[0] + 1) for r in ranges]
+
+
+def align(value):
+    return (value + 3) & ~3
+
+
+def build(cards):
+    cards = sorted(cards, key=lambda c: c["id"])
+    ids = [c["id"] for c in cards]
+    ranges = build_ranges(ids)
+
+    strings = StringPool()
+    records = bytearray()
+    for card in cards:
+        name = strings.add(card.get("printed_name") or card["name"])
+        slug = strings.add(card_slug(card))
+        text = strings.add(card.get("card_text", ""))
+        records += struct.pack(RECORD_FORMAT, card["id"], card_type(card), *name, *slug, *text,
+                               card_capacity(card), 0, *card_disciplines(card))
+
+    record_index = {card_id: index for index, card_id in enumerate(ids)}
+    ranges_offset = struct.calcsize(HEADER_FORMAT)
+    slots_offset = ranges_offset + len(ranges) * struct.calcsize(RANGE_FORMAT)
+
+    range_table = bytearray()
+    slot_table = bytearray()
+    for first_id, count in ranges:
+        range_table += struct.pack(RANGE_FORMAT, first_id, count, slots_offset + len(slot_table), 0)
+        for card_id in range(first_id, first_id + count):
+            slot_table += struct.pack("<I", record_index.get(card_id, -1) + 1)
+
+    records_offset = align(slots_offset + len(slot_table))
+    strings_offset = records_offset + len(records)
+    header = struct.pack(HEADER_FORMAT, MAGIC, FORMAT_VERSION, len(cards), len(ranges),
+                         ranges_offset, records_offset, strings_offset, len(strings.data))
+
+    blob = bytearray(header + range_table + slot_table)
+    blob += b"\0" * (records_offset - len(blob))
+    return bytes(blob + records + strings.data)
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("usage: build_card_db.py <vtes.json> <cards.db>", file=sys.stderr)
+        return 1
+
+    with open(sys.argv[1], encoding="utf-8") as source:
+        cards = json.load(source)
+
+    blob = build(cards)
+    with open(sys.argv[2], "wb") as target:
+        target.write(blob)
+
+    print("Wrote %d cards (%d bytes) to %s" % (len(cards), len(blob), sys.argv[2]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "card_database.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+constexpr char MAGIC[4] = {'S', 'N', 'C', 'D'};
+constexpr quint32 HEADER_SIZE = 32;
+constexpr quint32 RANGE_SIZE = 16;
+constexpr quint32 RECORD_SIZE_V1 = 32;
+constexpr quint32 RECORD_SIZE = 56;
+constexpr quint32 RECORD_STRINGS_END = 32; // Name, slug and text fields end here in every version
+
+quint32 readU32(const uchar* base, quint32 offset)
+{
+    return qFromLittleEndian<quint32>(base + offset);
+}
+
+quint64 readU64(const uchar* base, quint32 offset)
+{
+    return qFromLittleEndian<quint64>(base + offset);
+}
+
+} // namespace
+
+const CardDatabase& CardDatabase::instance()
+{
+    static const CardDatabase* database = []() {
+        auto* db = new CardDatabase();
+        for (const QString& path : defaultSearchPaths()) {
+            if (QFile::exists(path) && db->open(path)) {
+                break;
+            }
+        }
+        if (!db->isOpen()) {
+            qDebug() << "No card database found, card ids cannot be resolved";
+        }
+        return db;
+    }();
+    return *database;
+}
+
+CardDatabase::~CardDatabase()
+{
+    close();
+}
+
+QStringList CardDatabase::defaultSearchPaths()
+{
+    QStringList paths;
+    const QString env_path = qEnvironmentVariable("SCHRECKNET_CARD_DB");
+    if (!env_path.isEmpty()) {
+        paths << env_path;
+    }
+    const QString app_data_path = QStandardPaths::locate(QStandardPaths::AppDataLocation, "cards.db");
+    if (!app_data_path.isEmpty()) {
+        paths << app_data_path;
+    }
+    if (QCoreApplication::instance()) {
+        paths << QCoreApplication::applicationDirPath() + "/cards.db";
+    }
+    // Embedded copy, always present in the wasm build
+    paths << ":/data/cards.db";
+    return paths;
+}
+
+bool CardDatabase::open(const QString& file_path)
+{
+    close();
+
+    file.setFileName(file_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Cannot open card database:" << file_path;
+        return false;
+    }
+
+    size = file.size();
+    data = file.map(0, size);
+    if (!data) {
+        // Compressed resources and some wasm file systems cannot be mapped, keep one private copy instead
+        fallback_data = file.readAll();
+        data = reinterpret_cast<const uchar*>(fallback_data.constData());
+        size = fallback_data.size();
+    }
+
+    if (!validate()) {
+        qDebug() << "Invalid card database:" << file_path;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void CardDatabase::close()
+{
+    if (data && fallback_data.isEmpty()) {
+        file.unmap(const_cast<uchar*>(data));
+    }
+    file.close();
+    fallback_data.clear();
+    data = nullptr;
+    size = 0;
+    card_count = 0;
+    range_count = 0;
+    record_size = 0;
+}
+
+bool CardDatabase::validate()
+{
+    if (size < HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    const quint32 version = readU32(data, 4);
+    if (version != 1 && version != FORMAT_VERSION) {
+        return false;
+    }
+    record_size = version == 1 ? RECORD_SIZE_V1 : RECORD_SIZE;
+
+    card_count = readU32(data, 8);
+    range_count = readU32(data, 12);
+    ranges_offset = readU32(data, 16);
+    records_offset = readU32(data, 20);
+    strings_offset = readU32(data, 24);
+    strings_size = readU32(data, 28);
+
+    // Bounds are checked once here so lookups can skip them
+    if (quint64(ranges_offset) + quint64(range_count) * RANGE_SIZE > quint64(size)
+        || quint64(records_offset) + quint64(card_count) * record_size > quint64(size)
+        || quint64(strings_offset) + strings_size > quint64(size)) {
+        return false;
+    }
+    for (quint32 i = 0; i < range_count; ++i) {
+        const quint32 range = ranges_offset + i * RANGE_SIZE;
+        if (quint64(readU32(data, range + 8)) + quint64(readU32(data, range + 4)) * 4 > quint64(size)) {
+            return false;
+        }
+    }
+    for (quint32 i = 0; i < card_count; ++i) {
+        const quint32 record = records_offset + i * record_size;
+        for (quint32 field = 8; field < RECORD_STRINGS_END; field += 8) {
+            if (quint64(readU32(data, record + field)) + readU32(data, record + field + 4) > strings_size) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+CardDatabase::CardView CardDatabase::lookup(quint32 card_id) const
+{
+    for (quint32 i = 0; i < range_count; ++i) {
+        const quint32 range = ranges_offset + i * RANGE_SIZE;
+        const quint32 slot = card_id - readU32(data, range);
+        if (slot < readU32(data, range + 4)) {
+            const quint32 record_index = readU32(data, readU32(data, range + 8) + slot * 4);
+            return record_index ? cardAt(record_index - 1) : CardView();
+        }
+    }
+    return CardView();
+}
+
+CardDatabase::CardView CardDatabase::cardAt(quint32 record_index) const
+{
+    if (record_index >= card_count) {
+        return CardView();
+    }
+
+    const quint32 record = records_offset + record_index * record_size;
+    const char* strings = reinterpret_cast<const char*>(data + strings_offset);
+    auto string_at = [&](quint32 field) {
+        return QUtf8StringView(strings + readU32(data, record + field), readU32(data, record + field + 4));
+    };
+
+    CardView view;
+    view.id = readU32(data, record);
+    view.type = static_cast<Card::Type>(readU32(data, record + 4));
+    view.name = string_at(8);
+    view.slug = string_at(16);
+    view.text = string_at(24);
+    if (record_size >= RECORD_SIZE) {
+        view.capacity = int(readU32(data, record + 32));
+        view.disciplines = readU64(data, record + 40);
+        view.superior_disciplines = readU64(data, record + 48);
+    }
+    return view;
+}
+
+Card CardDatabase::toCard(const CardView& view) const
+{
+    Card card(view.name.toString(), view.type, imageUrlForSlug(view.slug));
+    card.setId(view.id);
+    card.setText(view.text.toString());
+    card.setCapacity(view.capacity);
+    card.setDisciplines(view.disciplines, view.superior_disciplines);
+    return card;
+}
+
+QString CardDatabase::imageUrlForSlug(QUtf8StringView slug)
+{
+    return QString("https://static.krcg.org/card/%1.jpg").arg(slug.toString());
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QUtf8StringView>
+#include "models/card.h"
+
+/*
+ * Read-only VTES card database.
+ *
+ * The database is a compiled binary file (see meta/build_card_db.py) that is memory-mapped once and never parsed.
+ * Layout, all integers little-endian and all offsets relative to the start of the file:
+ *
+ *   Header   magic "SNCD", version, card count, id range count, ranges offset, records offset,
+ *            strings offset, strings size
+ *   Ranges   { first id, slot count, slots offset, reserved } per contiguous id block (library, crypt)
+ *   Slots    one quint32 per id in a range, holding record index + 1 (0 when the id is unused)
+ *   Records  { id, type bitmask, name offset/length, slug offset/length, text offset/length,
+ *            capacity, reserved, disciplines (64 bits), superior disciplines (64 bits) }
+ *   Strings  UTF-8 string pool referenced by the records
+ *
+ * Looking up a card id is a range check plus two array reads; the returned CardView points straight into the
+ * mapping, so resolving a deck does not allocate per card.
+ *
+ * Version 1 files end the records after the text; they still open, with no capacity or disciplines.
+ */
+class CardDatabase
+{
+public:
+    static constexpr quint32 FORMAT_VERSION = 2;
+
+    // Lightweight view on a single record; the string views stay valid for the lifetime of the database
+    struct CardView
+    {
+        quint32 id = 0;
+        Card::Type type = Card::Type::Token;
+        QUtf8StringView name;
+        QUtf8StringView slug;
+        QUtf8StringView text;
+        int capacity = 0;
+        quint64 disciplines = 0;          // Card::DISCIPLINE_COUNT bits, any level
+        quint64 superior_disciplines = 0;
+
+        bool isValid() const { return id != 0; }
+    };
+
+    // Process wide database, opened on first use from the default search locations
+    static const CardDatabase& instance();
+
+    CardDatabase() = default;
+    ~CardDatabase();
+
+    CardDatabase(const CardDatabase&) = delete;
+    CardDatabase& operator=(const CardDatabase&) = delete;
+
+    bool open(const QString& file_path);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    quint32 cardCount() const { return card_count; }
+    QString filePath() const { return file.fileName(); }
+
+    CardView lookup(quint32 card_id) const;
+    CardView cardAt(quint32 record_index) const;
+
+    // Builds a standalone Card (allocates the QStrings); prefer lookup() on hot paths
+    Card toCard(const CardView& view) const;
+
+    static QString imageUrlForSlug(QUtf8StringView slug);
+
+private:
+    static QStringList defaultSearchPaths();
+    bool validate();
+
+    QFile file;
+    QByteArray fallback_data; // Used when the file cannot be mapped (e.g. compressed resources)
+    const uchar* data = nullptr;
+    qint64 size = 0;
+
+    quint32 card_count = 0;
+    quint32 range_count = 0;
+    quint32 ranges_offset = 0;
+    quint32 records_offset = 0;
+    quint32 strings_offset = 0;
+    quint32 strings_size = 0;
+    quint32 record_size = 0;
+};
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "card_search_index.h"
+#include "card_database.h"
+#include <algorithm>
+
+namespace {
+
+// Whole-name prefix beats a word prefix, both beat any amount of trigram overlap
+constexpr float NAME_PREFIX_BONUS = 2.0f;
+constexpr float WORD_PREFIX_BONUS = 1.0f;
+
+} // namespace
+
+const CardSearchIndex& CardSearchIndex::instance()
+{
+    static const CardSearchIndex index(CardDatabase::instance());
+    return index;
+}
+
+CardSearchIndex::CardSearchIndex(const CardDatabase& database)
+{
+    const quint32 card_count = database.cardCount();
+    names.reserve(card_count);
+    trigram_counts.reserve(card_count);
+    for (quint32 record = 0; record < card_count; ++record) {
+        names.append(normalize(database.cardAt(record).name.toString()));
+
+        QList<Trigram> grams = trigrams(names.last());
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+        trigram_counts.append(quint16(grams.size()));
+        // Records are visited in order, so every posting list stays sorted
+        for (Trigram gram : std::as_const(grams)) {
+            postings[gram].append(record);
+        }
+    }
+}
+
+QString CardSearchIndex::normalize(const QString& text)
+{
+    const QString decomposed = text.normalized(QString::NormalizationForm_KD);
+    QString normalized;
+    normalized.reserve(decomposed.size());
+    bool pending_space = false;
+    for (const QChar c : decomposed) {
+        if (c.isLetterOrNumber()) {
+            if (pending_space && !normalized.isEmpty()) {
+                normalized += QLatin1Char(' ');
+            }
+            pending_space = false;
+            normalized += c.toLower();
+        } else if (c.isSpace() || c == QLatin1Char('-') || c == QLatin1Char('/')) {
+            pending_space = true;
+        }
+        // Combining marks and other punctuation ("'", ",", ".") are dropped
+    }
+    return normalized;
+}
+
+QList<CardSearchIndex::Trigram> CardSearchIndex::trigrams(const QString& normalized)
+{
+    // Padded with spaces so word starts and ends get trigrams of their own ("  c", " ca", ...)
+    const QString padded = QStringLiteral("  ") + normalized + QLatin1Char(' ');
+    QList<Trigram> grams;
+    grams.reserve(padded.size());
+    for (qsizetype i = 0; i + 2 < padded.size(); ++i) {
+        grams.append(Trigram(padded[i].unicode()) << 32 | Trigram(padded[i + 1].unicode()) << 16
+                     | Trigram(padded[i + 2].unicode()));
+    }
+    return grams;
+}
+
+QList<CardSearchIndex::Match> CardSearchIndex::search(const QString& query, int limit) const
+{
+    const QString needle = normalize(query);
+    if (needle.isEmpty() || limit <= 0) {
+        return {};
+    }
+
+    QList<Trigram> grams = trigrams(needle);
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+    // Count shared trigrams per candidate; only touched records are scored afterwards
+    QList<quint16> shared(names.size(), 0);
+    QList<quint32> candidates;
+    for (Trigram gram : std::as_const(grams)) {
+        const auto it = postings.constFind(gram);
+        if (it == postings.constEnd()) {
+            continue;
+        }
+        for (quint32 record : it.value()) {
+            if (shared[record]++ == 0) {
+                candidates.append(record);
+            }
+        }
+    }
+
+    const QString word_prefix = QLatin1Char(' ') + needle;
+    QList<Match> matches;
+    matches.reserve(candidates.size());
+    for (quint32 record : std::as_const(candidates)) {
+        // Jaccard similarity of the trigram sets
+        const float overlap = shared[record];
+        float score = overlap / (grams.size() + trigram_counts[record] - overlap);
+        if (names[record].startsWith(needle)) {
+            score += NAME_PREFIX_BONUS;
+        } else if (names[record].contains(word_prefix)) {
+            score += WORD_PREFIX_BONUS;
+        }
+        matches.append({record, score});
+    }
+
+    const auto by_score = [this](const Match& a, const Match& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        // Shorter names first on ties, then a stable order
+        if (names[a.record].size() != names[b.record].size()) {
+            return names[a.record].size() < names[b.record].size();
+        }
+        return a.record < b.record;
+    };
+    if (matches.size() > limit) {
+        std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(), by_score);
+        matches.resize(limit);
+    } else {
+        std::sort(matches.begin(), matches.end(), by_score);
+    }
+    return matches;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class CardDatabase;
+
+/*
+ * Fuzzy card name search over the card database.
+ *
+ * Names are normalized (case and accents folded, punctuation dropped) and split into trigrams once; every trigram
+ * maps to the sorted list of records containing it. A query only walks the posting lists of its own trigrams, scores
+ * the candidates by trigram overlap and boosts prefix matches, so a keystroke costs a few thousand increments
+ * instead of a scan with edit distances.
+ */
+class CardSearchIndex
+{
+public:
+    struct Match
+    {
+        quint32 record = 0; // Record index in the CardDatabase, see CardDatabase::cardAt
+        float score = 0;
+    };
+
+    // Index over CardDatabase::instance(), built on first use
+    static const CardSearchIndex& instance();
+
+    explicit CardSearchIndex(const CardDatabase& database);
+
+    // Best matches first, at most limit results
+    QList<Match> search(const QString& query, int limit) const;
+
+    int size() const { return names.size(); }
+
+    // "Cats' Guidance" -> "cats guidance", "Šárka" -> "sarka"
+    static QString normalize(const QString& text);
+
+private:
+    using Trigram = quint64;
+
+    QList<QString> names; // Normalized names by record index
+    QList<quint16> trigram_counts;
+    QHash<Trigram, QList<quint32>> postings;
+
+    static QList<Trigram> trigrams(const QString& normalized);
+};
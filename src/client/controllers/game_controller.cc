@@ -4,19 +4,84 @@
  */
 
 #include "game_controller.h"
+#include "networking/message_dispatcher.h"
+#include "networking/server_connection.h"
 #include <QDebug>
+#include <QRandomGenerator>
 #include <QUrl>
 
 // GameController implementation
 GameController::GameController(QObject* parent)
     : QObject(parent)
     , deck_model(new DeckModel(this))
+    , deck_loader(new DeckLoader(this))
     , players_model(new GamePlayersModel(this))
+    , draw_odds_model(new DrawOddsModel(this))
+    , chat_model(new ChatModel(this))
     , game_name("Casual Standard")
-    , current_player("PlayerOne")
-    , game_phase("")
     , is_host(false)
+    , deck_loading(false)
+    , deck_load_progress(0)
 {
+    // Every deck swap (load, sample, clear) resets the model; edits through the search box do not restart the odds
+    connect(deck_model, &QAbstractItemModel::modelReset, this, [this]() {
+        draw_odds_model->simulate(deck_model->getContents());
+    });
+    draw_odds_model->simulate(deck_model->getContents());
+    connect(deck_loader, &DeckLoader::progressChanged, this, &GameController::setDeckLoadProgress);
+    connect(deck_loader, &DeckLoader::loaded, this, &GameController::onDeckLoaded);
+    connect(deck_loader, &DeckLoader::failed, this, &GameController::onDeckLoadFailed);
+    connect(deck_loader, &DeckLoader::directoryImported, this,
+            [this](const QList<DeckContents>& decks, double decks_per_second) {
+                addSystemMessage(QString("Imported %1 decks (%2 decks/s).")
+                                     .arg(decks.size())
+                                     .arg(decks_per_second, 0, 'f', 1));
+            });
+    connect(deck_loader, &DeckLoader::canceled, this, [this]() {
+        setDeckLoading(false);
+        addSystemMessage("Deck loading canceled.");
+    });
+
+    MessageDispatcher* dispatcher = ServerConnection::instance()->getDispatcher();
+    dispatcher->subscribe(MessageType::GameChat, this, [this](const Message& message) {
+        QString game;
+        QString sender;
+        QString text;
+        if (message.read(game, sender, text) && game == game_name) {
+            chat_model->appendMessage(sender, text);
+        }
+    });
+    dispatcher->subscribe(MessageType::TableSnapshot, this, [this](const Message& message) { onTableSnapshot(message); });
+    dispatcher->subscribe(MessageType::TableDelta, this, [this](const Message& message) { onTableDelta(message); });
+    dispatcher->subscribe(MessageType::TurnChanged, this, [this](const Message& message) {
+        TurnState state;
+        if (message.read(state)) {
+            setTurnState(state);
+        }
+    });
+    dispatcher->subscribe(MessageType::GameActionEvent, this, [this](const Message& message) { onGameAction(message); });
+    dispatcher->subscribe(MessageType::ActionLogTail, this, [this](const Message& message) { onActionLogTail(message); });
+    dispatcher->subscribe(MessageType::DeckSeed, this, [this](const Message& message) {
+        quint64 seed = 0;
+        if (message.read(seed) && seed != table_seed) {
+            table_seed = seed;
+            dealDeck(DeckEngine::playerSeed(seed, ServerConnection::instance()->getSessionId()));
+        }
+    });
+    // Seats are resolved through the players, a new table can move them
+    connect(players_model, &QAbstractItemModel::modelReset, this, &GameController::turnChanged);
+
+    ServerConnection* connection = ServerConnection::instance();
+    connect(connection, &ServerConnection::connectionLost, this, [this]() {
+        addSystemMessage("Connection lost, reconnecting...");
+    });
+    connect(connection, &ServerConnection::resumed, this, [this](int replayed_events) {
+        addSystemMessage(QString("Reconnected, %1 missed updates applied.").arg(replayed_events));
+    });
+    connect(connection, &ServerConnection::sessionRestarted, this, [this]() {
+        addSystemMessage("Reconnected, but the game session expired. Leave and join the game again.");
+    });
+
     addSystemMessage("Game joined successfully!");
     addSystemMessage("Load your deck to begin playing.");
 }
@@ -29,22 +94,87 @@ void GameController::setGameName(const QString& name)
     }
 }
 
-void GameController::setCurrentPlayer(const QString& player)
+QString GameController::getCurrentPlayer() const
 {
-    if (current_player != player) {
-        current_player = player;
-        emit currentPlayerChanged();
+    return turn_state.isStarted() ? players_model->nameAt(turn_state.active_seat) : QString();
+}
+
+bool GameController::getIsMyTurn() const
+{
+    return turn_state.isStarted() && turn_state.active_seat == localSeat();
+}
+
+int GameController::localSeat() const
+{
+    ServerConnection* connection = ServerConnection::instance();
+    if (connection->isConnected()) {
+        return players_model->seatOf(connection->getSessionId());
     }
+    return players_model->seatOfName("CurrentUser");
 }
 
-void GameController::setGamePhase(const QString& phase)
+quint32 GameController::localPlayerId() const
 {
-    if (game_phase != phase) {
-        game_phase = phase;
-        emit gamePhaseChanged();
+    ServerConnection* connection = ServerConnection::instance();
+    if (connection->isConnected()) {
+        return connection->getSessionId();
+    }
+    return players_model->idAt(players_model->seatOfName("CurrentUser"));
+}
+
+void GameController::setTurnState(const TurnState& state)
+{
+    if (turn_state == state) {
+        return;
+    }
+    if (turn_state.turn != state.turn) {
+        table_bytes_last_turn = table_bytes_this_turn;
+        table_bytes_this_turn = 0;
+        emit tableBytesChanged();
+    }
+    turn_state = state;
+    emit turnChanged();
+}
+
+void GameController::requestTurnAction(TurnAction action)
+{
+    TurnState next = turn_state;
+    if (action == TurnAction::StartGame) {
+        next.seat_count = quint8(qMin(players_model->rowCount(), TurnState::MAX_SEATS));
+    } else if (!getIsMyTurn()) {
+        return;
+    }
+    if (!TurnMachine::apply(next, action)) {
+        return;
+    }
+
+    ServerConnection* connection = ServerConnection::instance();
+    if (connection->isConnected()) {
+        // The server checks the command with the same GameRules and answers with TurnChanged
+        connection->send(Message::create(MessageType::TurnCommand, static_cast<quint8>(action)));
+    } else {
+        applyLocally(GameAction::turn(localPlayerId(), action));
     }
 }
 
+bool GameController::applyLocally(const GameAction& action)
+{
+    if (action_log.head().table.players.isEmpty()) {
+        // The offline game starts from the sample table
+        action_log.checkpoint({players_model->tableState(), turn_state});
+    }
+    if (!action_log.append(action)) {
+        return false;
+    }
+
+    const TableState shown = players_model->tableState();
+    TableState target = action_log.head().table;
+    target.sequence = shown.sequence;
+    players_model->applyDelta(TableCodec::diff(shown, target));
+    setTurnState(action_log.head().turn);
+    return true;
+}
+
 void GameController::setChatMessage(const QString& message)
 {
     if (chat_message != message) {
@@ -77,19 +207,75 @@ void GameController::loadDeckFromFile(const QUrl& fileUrl)
             addSystemMessage("Sample deck loaded successfully! 60 cards total.");
         } else {
             addSystemMessage(QString("Loading deck from: %1").arg(filePath));
-            deck_model->loadDeck(filePath);
-            addSystemMessage("Deck loaded successfully!");
-            emit deckLoaded();
+            setDeckLoadProgress(0);
+            setDeckLoading(true);
+            deck_loader->load(filePath);
         }
     }
 }
 
+void GameController::cancelDeckLoad()
+{
+    deck_loader->cancel();
+}
+
+void GameController::importDeckDirectory(const QUrl& folderUrl)
+{
+    const QString directory = folderUrl.toLocalFile();
+    if (directory.isEmpty()) {
+        addSystemMessage("Invalid folder path.");
+        return;
+    }
+    addSystemMessage(QString("Importing decks from: %1").arg(directory));
+    deck_loader->importDirectory(directory);
+}
+
+void GameController::onDeckLoaded(const DeckContents& contents)
+{
+    // The only GUI thread work of a load: swap the prepared contents into the model
+    deck_model->setDeck(contents);
+    setDeckLoading(false);
+    addSystemMessage(QString("Deck loaded successfully! %1 crypt / %2 library cards.")
+                         .arg(contents.crypt_size)
+                         .arg(contents.library_size));
+    emit deckLoaded();
+}
+
+void GameController::onDeckLoadFailed(const QString& file_path)
+{
+    setDeckLoading(false);
+    addSystemMessage(QString("Failed to parse %1. Loading sample deck...").arg(file_path));
+    deck_model->loadDeck("");
+}
+
+void GameController::setDeckLoading(bool loading)
+{
+    if (deck_loading != loading) {
+        deck_loading = loading;
+        emit deckLoadingChanged();
+    }
+}
+
+void GameController::setDeckLoadProgress(int progress)
+{
+    if (deck_load_progress != progress) {
+        deck_load_progress = progress;
+        emit deckLoadProgressChanged();
+    }
+}
+
 void GameController::sendChatMessage()
 {
     if (!chat_message.trimmed().isEmpty()) {
-        QString formatted_message = QString("[CurrentUser]: %1").arg(chat_message);
-        chat_history.append(formatted_message);
-        emit chatHistoryChanged();
+        ServerConnection* connection = ServerConnection::instance();
+        if (connection->isConnected()) {
+            // The server echoes the message back to everyone in the game, including us
+            if (!connection->sendChat(Message::create(MessageType::GameChat, game_name, QString(), chat_message))) {
+                addSystemMessage("You are sending messages too fast, message dropped.");
+            }
+        } else {
+            chat_model->appendMessage("CurrentUser", chat_message);
+        }
         
         setChatMessage("");
     }
@@ -98,6 +284,10 @@ void GameController::sendChatMessage()
 void GameController::leaveGame()
 {
     addSystemMessage("Leaving game...");
+    ServerConnection* connection = ServerConnection::instance();
+    if (connection->isConnected()) {
+        connection->send(Message::create(MessageType::LeaveGame));
+    }
     emit gameLeft();
 }
 
@@ -105,41 +295,136 @@ void GameController::startGame()
 {
     if (is_host) {
         addSystemMessage("Starting game...");
-        setGamePhase("Unlock");
-        players_model->updatePlayerStatus("PlayerOne", "Playing");
-        players_model->updatePlayerStatus("ProPlayer", "Playing");
-        players_model->updatePlayerStatus("CurrentUser", "Playing");
+        requestTurnAction(TurnAction::StartGame);
+        if (!ServerConnection::instance()->isConnected()) {
+            // Online the deal waits for the server's DeckSeed
+            dealDeck(QRandomGenerator::global()->generate64());
+        }
     }
 }
 
+void GameController::nextPhase()
+{
+    requestTurnAction(TurnAction::NextPhase);
+}
+
 void GameController::endTurn()
 {
     addSystemMessage("Turn ended.");
-    // In a real implementation, this would handle turn logic
-    if (current_player == "CurrentUser") {
-        setCurrentPlayer("PlayerOne");
-    } else if (current_player == "PlayerOne") {
-        setCurrentPlayer("ProPlayer");
-    } else {
-        setCurrentPlayer("CurrentUser");
-    }
+    requestTurnAction(TurnAction::EndTurn);
 }
 
 void GameController::setReady()
 {
     addSystemMessage("You are now ready to play.");
-    players_model->updatePlayerStatus("CurrentUser", "Ready");
+    sendPlayerStatus(PlayerStatus::Ready);
 }
 
 void GameController::concede()
 {
     addSystemMessage("You have conceded the game.");
-    players_model->updatePlayerStatus("CurrentUser", "Conceded");
+    sendPlayerStatus(PlayerStatus::Conceded);
+}
+
+void GameController::drawCard()
+{
+    if (deck_engine.draw(DeckEngine::Zone::Library, DeckEngine::Zone::Hand) != Pile::NO_CARD) {
+        emit pilesChanged();
+    }
+}
+
+void GameController::drawCrypt()
+{
+    if (deck_engine.draw(DeckEngine::Zone::Crypt, DeckEngine::Zone::Uncontrolled) != Pile::NO_CARD) {
+        emit pilesChanged();
+    }
+}
+
+void GameController::dealDeck(quint64 seed)
+{
+    QList<quint32> crypt;
+    QList<quint32> library;
+    const QList<DeckEntry>& entries = deck_model->getEntries();
+    for (int row : deck_model->expandCopies()) {
+        (entries[row].card->isCrypt() ? crypt : library).append(quint32(row));
+    }
+    if (!deck_engine.reset(crypt, library, seed)) {
+        addSystemMessage("The deck is too large to play with.");
+    } else {
+        addSystemMessage(QString("Deck shuffled: %1 crypt and %2 library cards left, %3 cards in hand.")
+                             .arg(getCryptRemaining())
+                             .arg(getLibraryRemaining())
+                             .arg(getHandCount()));
+    }
+    emit pilesChanged();
+}
+
+void GameController::sendPlayerStatus(PlayerStatus status)
+{
+    ServerConnection* connection = ServerConnection::instance();
+    if (connection->isConnected()) {
+        // Comes back with the next table delta
+        connection->send(Message::create(MessageType::PlayerStatusChange, static_cast<quint8>(status)));
+    } else {
+        applyLocally(GameAction::status(localPlayerId(), status));
+    }
+}
+
+void GameController::onGameAction(const Message& message)
+{
+    quint32 index = 0;
+    quint64 record = 0;
+    GameAction action;
+    if (!message.read(index, record) || !GameAction::unpack(record, action) || index < action_log.endIndex()) {
+        return;
+    }
+    if (index == action_log.endIndex() && action_log.append(action)) {
+        return;
+    }
+    // An action was missed, or the log no longer agrees with the server's: 0 asks for its latest snapshot
+    const quint32 known = index > action_log.endIndex() ? action_log.endIndex() : 0;
+    ServerConnection::instance()->send(Message::create(MessageType::ActionLogRequest, known));
+}
+
+void GameController::onActionLogTail(const Message& message)
+{
+    if (!action_log.applyTail(message.payload)) {
+        qWarning() << "Action log tail does not apply," << message.payload.size() << "bytes";
+        return;
+    }
+    setTurnState(action_log.head().turn);
+}
+
+void GameController::onTableSnapshot(const Message& message)
+{
+    TableState state;
+    if (!TableCodec::decodeSnapshot(message.payload, state)) {
+        qWarning() << "Malformed table snapshot," << message.payload.size() << "bytes";
+        return;
+    }
+    table_bytes_this_turn += message.payload.size();
+    emit tableBytesChanged();
+    players_model->applySnapshot(state);
+}
+
+void GameController::onTableDelta(const Message& message)
+{
+    TableDelta delta;
+    if (!TableCodec::decodeDelta(message.payload, delta)) {
+        qWarning() << "Malformed table delta," << message.payload.size() << "bytes";
+        return;
+    }
+    table_bytes_this_turn += message.payload.size();
+    emit tableBytesChanged();
+    if (!players_model->applyDelta(delta)) {
+        // A delta was missed (e.g. it arrived before the snapshot), start over from a fresh snapshot
+        qDebug() << "Table delta" << delta.base_sequence << "->" << delta.sequence << "does not follow"
+                 << players_model->getTableSequence() << ", requesting a snapshot";
+        ServerConnection::instance()->send(Message::create(MessageType::TableSnapshotRequest));
+    }
 }
 
 void GameController::addSystemMessage(const QString& message)
 {
-    QString formatted_message = QString("* %1").arg(message);
-    chat_history.append(formatted_message);
-    emit chatHistoryChanged();
+    chat_model->appendSystemMessage(message);
 }
@@ -9,8 +9,15 @@
 #include <QStringList>
 #include <QUrl>
 #include <qqmlregistration.h>
+#include "models/chat_model.h"
+#include "models/deck_loader.h"
 #include "models/deck_model.h"
+#include "models/draw_odds_model.h"
 #include "models/game_players_model.h"
+#include "game/action_log.h"
+#include "game/deck_engine.h"
+#include "game/turn_state.h"
+#include "networking/message.h"
 
 class GameController : public QObject
 {
@@ -19,60 +26,115 @@ class GameController : public QObject
     
     Q_PROPERTY(DeckModel* deckModel READ getDeckModel CONSTANT)
     Q_PROPERTY(GamePlayersModel* playersModel READ getPlayersModel CONSTANT)
+    Q_PROPERTY(DrawOddsModel* drawOddsModel READ getDrawOddsModel CONSTANT)
     Q_PROPERTY(QString gameName READ getGameName WRITE setGameName NOTIFY gameNameChanged)
-    Q_PROPERTY(QString currentPlayer READ getCurrentPlayer WRITE setCurrentPlayer NOTIFY currentPlayerChanged)
-    Q_PROPERTY(QString gamePhase READ getGamePhase WRITE setGamePhase NOTIFY gamePhaseChanged)
+    Q_PROPERTY(QString currentPlayer READ getCurrentPlayer NOTIFY turnChanged)
+    Q_PROPERTY(QString gamePhase READ getGamePhase NOTIFY turnChanged)
+    Q_PROPERTY(int activeSeat READ getActiveSeat NOTIFY turnChanged)
+    Q_PROPERTY(int turn READ getTurn NOTIFY turnChanged)
+    Q_PROPERTY(bool isMyTurn READ getIsMyTurn NOTIFY turnChanged)
     Q_PROPERTY(QString chatMessage READ getChatMessage WRITE setChatMessage NOTIFY chatMessageChanged)
-    Q_PROPERTY(QStringList chatHistory READ getChatHistory NOTIFY chatHistoryChanged)
+    Q_PROPERTY(ChatModel* chatModel READ getChatModel CONSTANT)
     Q_PROPERTY(bool isHost READ getIsHost WRITE setIsHost NOTIFY isHostChanged)
+    Q_PROPERTY(bool deckLoading READ getDeckLoading NOTIFY deckLoadingChanged)
+    Q_PROPERTY(int deckLoadProgress READ getDeckLoadProgress NOTIFY deckLoadProgressChanged)
+    Q_PROPERTY(int cryptRemaining READ getCryptRemaining NOTIFY pilesChanged)
+    Q_PROPERTY(int libraryRemaining READ getLibraryRemaining NOTIFY pilesChanged)
+    Q_PROPERTY(int handCount READ getHandCount NOTIFY pilesChanged)
+    Q_PROPERTY(int ashHeapCount READ getAshHeapCount NOTIFY pilesChanged)
+    // Table snapshot and delta payload bytes received in the current and in the previous turn
+    Q_PROPERTY(qint64 tableBytesThisTurn READ getTableBytesThisTurn NOTIFY tableBytesChanged)
+    Q_PROPERTY(qint64 tableBytesLastTurn READ getTableBytesLastTurn NOTIFY tableBytesChanged)
 
 public:
     explicit GameController(QObject* parent = nullptr);
 
     DeckModel* getDeckModel() const { return deck_model; }
     GamePlayersModel* getPlayersModel() const { return players_model; }
+    DrawOddsModel* getDrawOddsModel() const { return draw_odds_model; }
     QString getGameName() const { return game_name; }
-    QString getCurrentPlayer() const { return current_player; }
-    QString getGamePhase() const { return game_phase; }
+    QString getCurrentPlayer() const;
+    QString getGamePhase() const { return phaseToString(turn_state.phase); }
+    int getActiveSeat() const { return turn_state.isStarted() ? turn_state.active_seat : -1; }
+    int getTurn() const { return turn_state.turn; }
+    bool getIsMyTurn() const;
     QString getChatMessage() const { return chat_message; }
-    QStringList getChatHistory() const { return chat_history; }
+    ChatModel* getChatModel() const { return chat_model; }
     bool getIsHost() const { return is_host; }
+    bool getDeckLoading() const { return deck_loading; }
+    int getDeckLoadProgress() const { return deck_load_progress; }
+    int getCryptRemaining() const { return deck_engine.size(DeckEngine::Zone::Crypt); }
+    int getLibraryRemaining() const { return deck_engine.size(DeckEngine::Zone::Library); }
+    int getHandCount() const { return deck_engine.size(DeckEngine::Zone::Hand); }
+    int getAshHeapCount() const { return deck_engine.size(DeckEngine::Zone::AshHeap); }
+    qint64 getTableBytesThisTurn() const { return table_bytes_this_turn; }
+    qint64 getTableBytesLastTurn() const { return table_bytes_last_turn; }
 
     void setGameName(const QString& name);
-    void setCurrentPlayer(const QString& player);
-    void setGamePhase(const QString& phase);
     void setChatMessage(const QString& message);
     void setIsHost(bool host);
 
 public slots:
     Q_INVOKABLE void loadDeckFromFile(const QUrl& fileUrl = QUrl());
+    Q_INVOKABLE void cancelDeckLoad();
+    Q_INVOKABLE void importDeckDirectory(const QUrl& folderUrl);
     Q_INVOKABLE void sendChatMessage();
     Q_INVOKABLE void leaveGame();
     Q_INVOKABLE void startGame(); // Host only
+    Q_INVOKABLE void nextPhase();
     Q_INVOKABLE void endTurn();
     Q_INVOKABLE void setReady();
     Q_INVOKABLE void concede();
+    Q_INVOKABLE void drawCard();
+    Q_INVOKABLE void drawCrypt();
 
 signals:
     void gameNameChanged();
-    void currentPlayerChanged();
-    void gamePhaseChanged();
+    // Seat, phase or turn number changed
+    void turnChanged();
     void chatMessageChanged();
-    void chatHistoryChanged();
     void isHostChanged();
+    void deckLoadingChanged();
+    void deckLoadProgressChanged();
+    // Cards moved between crypt, library, hand, uncontrolled region and ash heap
+    void pilesChanged();
+    void tableBytesChanged();
     void gameLeft();
     void deckLoaded();
 
 private:
     DeckModel* deck_model;
+    DeckLoader* deck_loader;
     GamePlayersModel* players_model;
+    DrawOddsModel* draw_odds_model;
+    ChatModel* chat_model;
     QString game_name;
-    QString current_player;
-    QString game_phase;
+    TurnState turn_state;
     QString chat_message;
-    QStringList chat_history;
     bool is_host;
+    bool deck_loading;
+    int deck_load_progress;
+    qint64 table_bytes_this_turn = 0; // Table snapshot and delta payloads received since the turn started
+    qint64 table_bytes_last_turn = 0;
+    DeckEngine deck_engine;           // Piles hold DeckModel rows, dealt when the game starts
+    quint64 table_seed = 0;           // Last seed from the server, the piles were dealt with it
+    ActionLog action_log;             // Mirrors the server's log, offline it is the game state itself
 
     void addSystemMessage(const QString& message);
+    void setDeckLoading(bool loading);
+    void setDeckLoadProgress(int progress);
+    void onDeckLoaded(const DeckContents& contents);
+    void onDeckLoadFailed(const QString& file_path);
+    void onTableSnapshot(const Message& message);
+    void onTableDelta(const Message& message);
+    void sendPlayerStatus(PlayerStatus status);
+    void requestTurnAction(TurnAction action);
+    void setTurnState(const TurnState& state);
+    int localSeat() const;
+    quint32 localPlayerId() const;
+    bool applyLocally(const GameAction& action);
+    void onGameAction(const Message& message);
+    void onActionLogTail(const Message& message);
+    void dealDeck(quint64 seed);
 };
 
@@ -4,13 +4,16 @@
  */
 
 #include "game_lobby_controller.h"
+#include "networking/message_dispatcher.h"
+#include "networking/server_connection.h"
 #include <QDebug>
 
 // GameListModel implementation
 GameListModel::GameListModel(QObject* parent)
     : QAbstractListModel(parent)
 {
-    loadSampleGames();
+    games = sampleGames();
+    reindexFrom(0);
 }
 
 int GameListModel::rowCount(const QModelIndex& parent) const
@@ -43,6 +46,8 @@ QVariant GameListModel::data(const QModelIndex& index, int role) const
         return game.password_protected;
     case BuddiesOnlyRole:
         return game.buddies_only;
+    case GameIdRole:
+        return game.id;
     }
 
     return QVariant();
@@ -59,6 +64,7 @@ QHash<int, QByteArray> GameListModel::roleNames() const
     roles[SpectatorsRole] = "spectators";
     roles[PasswordProtectedRole] = "passwordProtected";
     roles[BuddiesOnlyRole] = "buddiesOnly";
+    roles[GameIdRole] = "gameId";
     return roles;
 }
 
@@ -66,38 +72,134 @@ void GameListModel::addGame(const QString& name, const QString& host, const QStr
                           int current_players, int max_players, int spectators,
                           bool password_protected, bool buddies_only)
 {
-    beginInsertRows(QModelIndex(), games.size(), games.size());
-    games.append({name, host, format, current_players, max_players, spectators, password_protected, buddies_only});
-    endInsertRows();
+    insertGame({next_local_id++, name, host, format, current_players, max_players, spectators, password_protected,
+                buddies_only});
 }
 
 void GameListModel::removeGame(int index)
 {
     if (index >= 0 && index < games.size()) {
-        beginRemoveRows(QModelIndex(), index, index);
-        games.removeAt(index);
-        endRemoveRows();
+        removeGameById(games[index].id);
     }
 }
 
 void GameListModel::refresh()
 {
-    beginResetModel();
-    games.clear();
-    loadSampleGames();
-    endResetModel();
+    // Offline refresh, diffed like a server snapshot so delegates and scroll position survive
+    syncGames(sampleGames());
+}
+
+void GameListModel::syncGames(const QList<GameInfo>& snapshot)
+{
+    QHash<quint32, int> snapshot_rows;
+    snapshot_rows.reserve(snapshot.size());
+    for (int i = 0; i < snapshot.size(); ++i) {
+        snapshot_rows.insert(snapshot[i].id, i);
+    }
+
+    // Drop games that are gone, back to front so the rows still to visit keep their index
+    for (int row = games.size() - 1; row >= 0; --row) {
+        if (!snapshot_rows.contains(games[row].id)) {
+            beginRemoveRows(QModelIndex(), row, row);
+            row_by_id.remove(games[row].id);
+            games.removeAt(row);
+            endRemoveRows();
+        }
+    }
+    reindexFrom(0);
+
+    for (const GameInfo& game : snapshot) {
+        insertGame(game);
+    }
+}
+
+void GameListModel::insertGame(const GameInfo& game)
+{
+    const int row = rowForId(game.id);
+    if (row >= 0) {
+        updateGame(row, game);
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), games.size(), games.size());
+    row_by_id.insert(game.id, games.size());
+    games.append(game);
+    endInsertRows();
+}
+
+void GameListModel::removeGameById(quint32 game_id)
+{
+    const int row = rowForId(game_id);
+    if (row < 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    row_by_id.remove(game_id);
+    games.removeAt(row);
+    endRemoveRows();
+    // Only the rows behind the removed game move
+    reindexFrom(row);
+}
+
+void GameListModel::updateCounts(quint32 game_id, int current_players, int spectators)
+{
+    const int row = rowForId(game_id);
+    if (row < 0) {
+        return;
+    }
+
+    GameInfo game = games[row];
+    game.current_players = current_players;
+    game.spectators = spectators;
+    updateGame(row, game);
+}
+
+void GameListModel::updateGame(int row, const GameInfo& game)
+{
+    GameInfo& current = games[row];
+    QList<int> roles;
+    if (current.name != game.name)
+        roles << NameRole;
+    if (current.host != game.host)
+        roles << HostRole;
+    if (current.format != game.format)
+        roles << FormatRole;
+    if (current.current_players != game.current_players)
+        roles << CurrentPlayersRole;
+    if (current.max_players != game.max_players)
+        roles << MaxPlayersRole;
+    if (current.spectators != game.spectators)
+        roles << SpectatorsRole;
+    if (current.password_protected != game.password_protected)
+        roles << PasswordProtectedRole;
+    if (current.buddies_only != game.buddies_only)
+        roles << BuddiesOnlyRole;
+
+    if (!roles.isEmpty()) {
+        current = game;
+        const QModelIndex idx = index(row);
+        emit dataChanged(idx, idx, roles);
+    }
+}
+
+void GameListModel::reindexFrom(int row)
+{
+    for (int i = row; i < games.size(); ++i) {
+        row_by_id.insert(games[i].id, i);
+    }
 }
 
-void GameListModel::loadSampleGames()
+QList<GameInfo> GameListModel::sampleGames()
 {
     // Sample game data
-    games = {
-        /* Name, Host Player, Format, Player Count, Seats Available, Spectator Count, Password, Buddies */
-        {"Casual Standard", "PlayerOne", "Rated Regular", 2, 5, 1, false, false},
-        {"Competitive Modern", "ProPlayer", "Casual Dual", 1, 2, 0, false, false},
-        {"Friends Only", "BuddyHost", "Legacy", 3, 5, 0, false, true},
-        {"Tournament Practice", "TourneyPrep", "Standard", 4, 5, 2, true, false},
-        {"Beginner Friendly", "NewbieHelper", "Pauper", 1, 5, 0, true, true}
+    return {
+        /* Id, Name, Host Player, Format, Player Count, Seats Available, Spectator Count, Password, Buddies */
+        {1, "Casual Standard", "PlayerOne", "Rated Regular", 2, 5, 1, false, false},
+        {2, "Competitive Modern", "ProPlayer", "Casual Dual", 1, 2, 0, false, false},
+        {3, "Friends Only", "BuddyHost", "Legacy", 3, 5, 0, false, true},
+        {4, "Tournament Practice", "TourneyPrep", "Standard", 4, 5, 2, true, false},
+        {5, "Beginner Friendly", "NewbieHelper", "Pauper", 1, 5, 0, true, true}
     };
 }
 
@@ -105,8 +207,56 @@ void GameListModel::loadSampleGames()
 GameLobbyController::GameLobbyController(QObject* parent)
     : QObject(parent)
     , game_model(new GameListModel(this))
+    , chat_model(new ChatModel(this))
     , player_name("Player")
 {
+    MessageDispatcher* dispatcher = ServerConnection::instance()->getDispatcher();
+    dispatcher->subscribe(MessageType::GameList, this, [this](const Message& message) {
+        QList<GameInfo> snapshot;
+        if (message.read(snapshot)) {
+            game_model->syncGames(snapshot);
+        }
+    });
+    dispatcher->subscribe(MessageType::GameAdded, this, [this](const Message& message) {
+        GameInfo game;
+        if (message.read(game)) {
+            game_model->insertGame(game);
+        }
+    });
+    dispatcher->subscribe(MessageType::GameRemoved, this, [this](const Message& message) {
+        quint32 game_id = 0;
+        if (message.read(game_id)) {
+            game_model->removeGameById(game_id);
+        }
+    });
+    dispatcher->subscribe(MessageType::GameUpdated, this, [this](const Message& message) {
+        quint32 game_id = 0;
+        qint32 current_players = 0;
+        qint32 spectators = 0;
+        if (message.read(game_id, current_players, spectators)) {
+            game_model->updateCounts(game_id, current_players, spectators);
+        }
+    });
+    dispatcher->subscribe(MessageType::LobbyChat, this, [this](const Message& message) {
+        QString sender;
+        QString text;
+        if (message.read(sender, text)) {
+            chat_model->appendMessage(sender, text);
+        }
+    });
+
+    ServerConnection* connection = ServerConnection::instance();
+    connect(connection, &ServerConnection::connectionLost, this, [this]() {
+        addSystemMessage("Connection lost, reconnecting...");
+    });
+    connect(connection, &ServerConnection::resumed, this, [this](int replayed_events) {
+        addSystemMessage(QString("Reconnected, %1 missed updates applied.").arg(replayed_events));
+    });
+    // The server sends a fresh game list after the new login, the list syncs itself
+    connect(connection, &ServerConnection::sessionRestarted, this, [this]() {
+        addSystemMessage("Reconnected with a new session.");
+    });
+
     addSystemMessage("Welcome to SchreckNET! Connected to server.");
     addSystemMessage("Type your message and press Enter to chat.");
 }
@@ -130,9 +280,15 @@ void GameLobbyController::setPlayerName(const QString& name)
 void GameLobbyController::sendChatMessage()
 {
     if (!chat_message.trimmed().isEmpty()) {
-        QString formatted_message = QString("[%1]: %2").arg(player_name, chat_message);
-        chat_history.append(formatted_message);
-        emit chatHistoryChanged();
+        ServerConnection* connection = ServerConnection::instance();
+        if (connection->isConnected()) {
+            // The server echoes the message back to everyone, including us
+            if (!connection->sendChat(Message::create(MessageType::LobbyChat, QString(), chat_message))) {
+                addSystemMessage("You are sending messages too fast, message dropped.");
+            }
+        } else {
+            chat_model->appendMessage(player_name, chat_message);
+        }
         
         setChatMessage("");
     }
@@ -144,6 +300,11 @@ void GameLobbyController::joinGame(int game_index)
         QModelIndex index = game_model->index(game_index);
         QString game_name = game_model->data(index, GameListModel::NameRole).toString();
         
+        ServerConnection* connection = ServerConnection::instance();
+        if (connection->isConnected()) {
+            const quint32 game_id = game_model->data(index, GameListModel::GameIdRole).toUInt();
+            connection->send(Message::create(MessageType::JoinGame, game_id, false));
+        }
         addSystemMessage(QString("Attempting to join game: %1").arg(game_name));
         emit gameJoined(game_name);
     }
@@ -155,6 +316,11 @@ void GameLobbyController::spectateGame(int game_index)
         QModelIndex index = game_model->index(game_index);
         QString game_name = game_model->data(index, GameListModel::NameRole).toString();
         
+        ServerConnection* connection = ServerConnection::instance();
+        if (connection->isConnected()) {
+            const quint32 game_id = game_model->data(index, GameListModel::GameIdRole).toUInt();
+            connection->send(Message::create(MessageType::JoinGame, game_id, true));
+        }
         addSystemMessage(QString("Spectating game: %1").arg(game_name));
     }
 }
@@ -165,9 +331,34 @@ void GameLobbyController::createGame()
     emit gameCreated();
 }
 
+void GameLobbyController::hostGame(const QString& name, const QString& format, int max_players,
+                                   bool password_protected, bool buddies_only)
+{
+    ServerConnection* connection = ServerConnection::instance();
+    if (!connection->isConnected()) {
+        game_model->addGame(name, player_name, format, 1, max_players, 0, password_protected, buddies_only);
+        return;
+    }
+
+    // Shows up in the list once the server broadcasts GameAdded
+    GameInfo game;
+    game.name = name;
+    game.format = format;
+    game.max_players = max_players;
+    game.password_protected = password_protected;
+    game.buddies_only = buddies_only;
+    connection->send(Message::create(MessageType::CreateGame, game));
+}
+
 void GameLobbyController::refreshGames()
 {
-    game_model->refresh();
+    ServerConnection* connection = ServerConnection::instance();
+    if (connection->isConnected()) {
+        // The snapshot is diffed against the current list, see GameListModel::syncGames
+        connection->send(Message::create(MessageType::GameListRequest));
+    } else {
+        game_model->refresh();
+    }
     addSystemMessage("Game list refreshed.");
 }
 
@@ -178,7 +369,5 @@ void GameLobbyController::openSettings()
 
 void GameLobbyController::addSystemMessage(const QString& message)
 {
-    QString formatted_message = QString("* %1").arg(message);
-    chat_history.append(formatted_message);
-    emit chatHistoryChanged();
+    chat_model->appendSystemMessage(message);
 }
\ No newline at end of file
@@ -7,20 +7,11 @@
 
 #include <QObject>
 #include <QAbstractListModel>
+#include <QHash>
 #include <QVariantMap>
 #include <qqmlregistration.h>
-
-struct GameInfo
-{
-    QString name;
-    QString host;
-    QString format;
-    int current_players;
-    int max_players;
-    int spectators;
-    bool password_protected;
-    bool buddies_only;
-};
+#include "game/game_info.h"
+#include "models/chat_model.h"
 
 class GameListModel : public QAbstractListModel
 {
@@ -36,7 +27,8 @@ public:
         MaxPlayersRole,
         SpectatorsRole,
         PasswordProtectedRole,
-        BuddiesOnlyRole
+        BuddiesOnlyRole,
+        GameIdRole
     };
 
     explicit GameListModel(QObject* parent = nullptr);
@@ -51,9 +43,22 @@ public:
     Q_INVOKABLE void removeGame(int index);
     Q_INVOKABLE void refresh();
 
+    // Server driven updates, keyed by game id and applied as row inserts/removals and per-role changes
+    void syncGames(const QList<GameInfo>& snapshot);
+    void insertGame(const GameInfo& game);
+    void removeGameById(quint32 game_id);
+    void updateCounts(quint32 game_id, int current_players, int spectators);
+    Q_INVOKABLE int rowForId(quint32 game_id) const { return row_by_id.value(game_id, -1); }
+
 private:
     QList<GameInfo> games;
-    void loadSampleGames();
+    QHash<quint32, int> row_by_id;
+    // Ids for games created while offline, kept clear of server ids
+    quint32 next_local_id = 0x80000000u;
+
+    void reindexFrom(int row);
+    void updateGame(int row, const GameInfo& game);
+    static QList<GameInfo> sampleGames();
 };
 
 class GameLobbyController : public QObject
@@ -63,7 +68,7 @@ class GameLobbyController : public QObject
     
     Q_PROPERTY(GameListModel* gameModel READ getGameModel CONSTANT)
     Q_PROPERTY(QString chatMessage READ getChatMessage WRITE setChatMessage NOTIFY chatMessageChanged)
-    Q_PROPERTY(QStringList chatHistory READ getChatHistory NOTIFY chatHistoryChanged)
+    Q_PROPERTY(ChatModel* chatModel READ getChatModel CONSTANT)
     Q_PROPERTY(QString playerName READ getPlayerName WRITE setPlayerName NOTIFY playerNameChanged)
 
 public:
@@ -71,7 +76,7 @@ public:
 
     GameListModel* getGameModel() const { return game_model; }
     QString getChatMessage() const { return chat_message; }
-    QStringList getChatHistory() const { return chat_history; }
+    ChatModel* getChatModel() const { return chat_model; }
     QString getPlayerName() const { return player_name; }
 
     void setChatMessage(const QString& message);
@@ -82,12 +87,13 @@ public slots:
     Q_INVOKABLE void joinGame(int game_index);
     Q_INVOKABLE void spectateGame(int game_index);
     Q_INVOKABLE void createGame();
+    Q_INVOKABLE void hostGame(const QString& name, const QString& format, int max_players,
+                              bool password_protected, bool buddies_only);
     Q_INVOKABLE void refreshGames();
     Q_INVOKABLE void openSettings();
 
 signals:
     void chatMessageChanged();
-    void chatHistoryChanged();
     void playerNameChanged();
     void gameJoined(const QString& game_name);
     void gameCreated();
@@ -96,7 +102,7 @@ signals:
 private:
     GameListModel* game_model;
     QString chat_message;
-    QStringList chat_history;
+    ChatModel* chat_model;
     QString player_name;
 
     void addSystemMessage(const QString& message);
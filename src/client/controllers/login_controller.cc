@@ -4,16 +4,38 @@
  */
 
 #include "login_controller.h"
+#include "networking/server_connection.h"
+#include "networking/server_prober.h"
 #include <QDebug>
 
 LoginController::LoginController(QObject* parent)
     : QObject(parent)
+    , prober(new ServerProber(this))
     , port("4747")
     , save_password(false)
     , auto_connect(false)
     , is_connected(false)
 {
+    connect(prober, &ServerProber::probeFinished, this,
+            [this](const QString& name, bool ok) { onProbeFinished(name, ok); });
+    connect(prober, &ServerProber::allProbesFinished, this, &LoginController::onAllProbesFinished);
+
+    ServerConnection* connection = ServerConnection::instance();
+    connect(connection, &ServerConnection::loggedIn, this, [this]() {
+        is_connected = true;
+        emit isConnectedChanged();
+        emit connectionSucceeded();
+    });
+    connect(connection, &ServerConnection::connectionFailed, this, &LoginController::connectionFailed);
+    connect(connection, &ServerConnection::disconnected, this, [this]() {
+        if (is_connected) {
+            is_connected = false;
+            emit isConnectedChanged();
+        }
+    });
+
     loadPreviousHosts();
+    refreshServers();
 }
 
 void LoginController::setSelectedHost(const QString& host)
@@ -85,11 +107,43 @@ void LoginController::setAutoConnect(bool auto_connect_)
     }
 }
 
+bool LoginController::getProbing() const
+{
+    return prober->isProbing();
+}
+
 void LoginController::refreshServers()
 {
-    // Simulate server refresh - in real implementation, this would fetch from network
+    // Probe all saved servers at once; the list is re-ranked when the last one answered or timed out
     qDebug() << "Refreshing server list...";
-    loadPreviousHosts();
+    QList<ServerProber::Endpoint> endpoints;
+    for (const SavedServer& server : std::as_const(saved_servers)) {
+        endpoints.append({server.name, server.host, server.port.toUShort()});
+    }
+    prober->probeAll(endpoints);
+    emit probingChanged();
+}
+
+void LoginController::onProbeFinished(const QString& name, bool ok)
+{
+    const ServerProber::Stats stats = prober->stats(name);
+    if (ok) {
+        const qint64 rtt_us = stats.averageRttUs();
+        server_latency[name] = rtt_us < 1000 ? QString("%1 us").arg(rtt_us) : QString("%1 ms").arg(rtt_us / 1000);
+    } else {
+        server_latency[name] = QString("offline");
+    }
+    emit serverLatencyChanged();
+}
+
+void LoginController::onAllProbesFinished()
+{
+    const QStringList ranked = prober->rank(previous_hosts);
+    if (ranked != previous_hosts) {
+        previous_hosts = ranked;
+        emit previousHostsChanged();
+    }
+    emit probingChanged();
 }
 
 bool LoginController::connectToServer()
@@ -104,13 +158,15 @@ bool LoginController::connectToServer()
         return false;
     }
     
-    // Simulate connection logic - in real implementation, this would attempt actual connection
-    qDebug() << "Connecting to" << host_url << ":" << port << "as" << player_name;
+    bool port_valid = false;
+    const quint16 port_number = port.toUShort(&port_valid);
+    if (!port_valid || port_number == 0) {
+        emit connectionFailed("Port must be a number between 1 and 65535.");
+        return false;
+    }
     
-    // For demo purposes, always succeed
-    is_connected = true;
-    emit isConnectedChanged();
-    emit connectionSucceeded();
+    // Answered asynchronously through connectionSucceeded or connectionFailed
+    ServerConnection::instance()->connectToServer(host_url, port_number, player_name, password);
     return true;
 }
 
@@ -122,8 +178,12 @@ void LoginController::forgotPassword()
 
 void LoginController::disconnect()
 {
-    is_connected = false;
-    emit isConnectedChanged();
+    ServerConnection::instance()->disconnectFromServer();
+    // Normally already cleared by the disconnected handler
+    if (is_connected) {
+        is_connected = false;
+        emit isConnectedChanged();
+    }
 }
 
 void LoginController::loadServerInfo(const QString& save_name)
@@ -132,17 +192,11 @@ void LoginController::loadServerInfo(const QString& save_name)
         return;
     }
     
-    // Simulate loading server info - in real implementation, this would load from settings
-    if (save_name == "Official Server") {
-        host_url = "server.schrecknet.com";
-        port = "4747";
-        server_contact = "https://schrecknet.com";
-        server_issues = "Official SchreckNET server. Contact support if you experience issues.";
-    } else if (save_name == "Test Server") {
-        host_url = "test.schrecknet.com";
-        port = "4748";
-        server_contact = "https://test.schrecknet.com";
-        server_issues = "Test server for development. May be unstable.";
+    if (const SavedServer* server = findSavedServer(save_name)) {
+        host_url = server->host;
+        port = server->port;
+        server_contact = server->contact;
+        server_issues = server->issues;
     } else {
         host_url = "";
         port = "4747";
@@ -156,10 +210,32 @@ void LoginController::loadServerInfo(const QString& save_name)
     emit serverIssuesChanged();
 }
 
+const LoginController::SavedServer* LoginController::findSavedServer(const QString& name) const
+{
+    for (const SavedServer& server : saved_servers) {
+        if (server.name == name) {
+            return &server;
+        }
+    }
+    return nullptr;
+}
+
 void LoginController::loadPreviousHosts()
 {
-    // Simulate loading previous hosts - in real implementation, this would load from settings
-    previous_hosts = {"Official Server", "Test Server", "Local Server"};
+    // Todo; load the saved servers from the settings
+    saved_servers = {
+        {"Official Server", "server.schrecknet.com", "4747", "https://schrecknet.com",
+         "Official SchreckNET server. Contact support if you experience issues."},
+        {"Test Server", "test.schrecknet.com", "4748", "https://test.schrecknet.com",
+         "Test server for development. May be unstable."},
+        // The stand-in server from src/server, see its --help
+        {"Local Server", "localhost", "4747", "", "Local stand-in server for development."},
+    };
+
+    previous_hosts.clear();
+    for (const SavedServer& server : std::as_const(saved_servers)) {
+        previous_hosts << server.name;
+    }
     emit previousHostsChanged();
     
     if (!previous_hosts.isEmpty()) {
@@ -8,8 +8,11 @@
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QVariantMap>
 #include <qqmlregistration.h>
 
+class ServerProber;
+
 class LoginController : public QObject
 {
     Q_OBJECT
@@ -27,6 +30,8 @@ class LoginController : public QObject
     Q_PROPERTY(bool isConnected READ getIsConnected NOTIFY isConnectedChanged)
     Q_PROPERTY(QString serverContact READ getServerContact NOTIFY serverContactChanged)
     Q_PROPERTY(QString serverIssues READ getServerIssues NOTIFY serverIssuesChanged)
+    Q_PROPERTY(bool probing READ getProbing NOTIFY probingChanged)
+    Q_PROPERTY(QVariantMap serverLatency READ getServerLatency NOTIFY serverLatencyChanged)
 
 public:
     explicit LoginController(QObject* parent = nullptr);
@@ -44,6 +49,9 @@ public:
     bool getIsConnected() const { return is_connected; }
     QString getServerContact() const { return server_contact; }
     QString getServerIssues() const { return server_issues; }
+    bool getProbing() const;
+    // Display text per saved server name, e.g. "23 ms" or "offline"
+    QVariantMap getServerLatency() const { return server_latency; }
 
     // Property setters
     void setSelectedHost(const QString& host);
@@ -75,12 +83,30 @@ signals:
     void isConnectedChanged();
     void serverContactChanged();
     void serverIssuesChanged();
+    void probingChanged();
+    void serverLatencyChanged();
     void connectionFailed(const QString& error);
     void connectionSucceeded();
 
 private:
+    struct SavedServer
+    {
+        QString name;
+        QString host;
+        QString port;
+        QString contact;
+        QString issues;
+    };
+
     void loadPreviousHosts();
     void updateServerInfo();
+    const SavedServer* findSavedServer(const QString& name) const;
+    void onProbeFinished(const QString& name, bool ok);
+    void onAllProbesFinished();
+
+    QList<SavedServer> saved_servers;
+    ServerProber* prober;
+    QVariantMap server_latency;
 
     QStringList previous_hosts;
     QString selected_host;
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "action_log.h"
+#include <QDataStream>
+#include <QIODevice>
+#include <algorithm>
+#include <utility>
+
+// GameAction implementation
+GameAction GameAction::turn(quint32 player_id, TurnAction action)
+{
+    return {Kind::Turn, static_cast<quint8>(action), player_id};
+}
+
+GameAction GameAction::status(quint32 player_id, PlayerStatus status)
+{
+    return {Kind::PlayerStatus, static_cast<quint8>(status), player_id};
+}
+
+bool GameAction::unpack(quint64 record, GameAction& action)
+{
+    const quint8 kind = quint8(record);
+    if (kind >= static_cast<quint8>(Kind::Count) || (record & 0xFFFF0000u) != 0) {
+        return false;
+    }
+    action.kind = static_cast<Kind>(kind);
+    action.value = quint8(record >> 8);
+    action.player_id = quint32(record >> 32);
+    return true;
+}
+
+// GameRules implementation
+bool GameRules::apply(GameState& state, const GameAction& action)
+{
+    const int seat = seatOf(state.table, action.player_id);
+    if (seat < 0) {
+        return false;
+    }
+
+    switch (action.kind) {
+    case GameAction::Kind::Turn: {
+        if (action.value >= static_cast<quint8>(TurnAction::Count)) {
+            return false;
+        }
+        const TurnAction turn_action = static_cast<TurnAction>(action.value);
+        TurnState next = state.turn;
+        if (turn_action == TurnAction::StartGame) {
+            next.seat_count = quint8(qMin<qsizetype>(state.table.players.size(), TurnState::MAX_SEATS));
+        } else if (seat != next.active_seat) {
+            return false;
+        }
+        if (!TurnMachine::apply(next, turn_action)) {
+            return false;
+        }
+        if (turn_action == TurnAction::StartGame) {
+            for (GamePlayer& player : state.table.players) {
+                player.status = PlayerStatus::Playing;
+            }
+        }
+        state.turn = next;
+        return true;
+    }
+    case GameAction::Kind::PlayerStatus: {
+        if (action.value >= static_cast<quint8>(PlayerStatus::Count)) {
+            return false;
+        }
+        const PlayerStatus status = static_cast<PlayerStatus>(action.value);
+        state.table.players[seat].status = status;
+        if ((status == PlayerStatus::Conceded || status == PlayerStatus::Ousted) && state.turn.isStarted()) {
+            TurnMachine::oust(state.turn, seat);
+        }
+        return true;
+    }
+    case GameAction::Kind::Count:
+        break;
+    }
+    return false;
+}
+
+int GameRules::seatOf(const TableState& table, quint32 player_id)
+{
+    for (int seat = 0; seat < table.players.size(); ++seat) {
+        if (table.players[seat].id == player_id) {
+            return seat;
+        }
+    }
+    return -1;
+}
+
+// ActionLog implementation
+ActionLog::ActionLog()
+{
+    clear();
+}
+
+void ActionLog::clear()
+{
+    actions.clear();
+    snapshots.clear();
+    head_state = GameState();
+    first_index = 0;
+    last_checkpoint = 0;
+    snapshot();
+}
+
+bool ActionLog::append(const GameAction& action)
+{
+    if (!GameRules::apply(head_state, action)) {
+        return false;
+    }
+    actions.append(action.pack());
+    if (endIndex() - snapshots.last().index >= SNAPSHOT_INTERVAL) {
+        snapshot();
+    }
+    if (actions.size() > MAX_ACTIONS) {
+        compact();
+    }
+    return true;
+}
+
+void ActionLog::checkpoint(const GameState& state)
+{
+    head_state = state;
+    last_checkpoint = endIndex();
+    snapshot();
+}
+
+bool ActionLog::stateAt(quint32 index, GameState& state) const
+{
+    if (index < first_index || index > endIndex()) {
+        return false;
+    }
+    if (index == endIndex()) {
+        state = head_state;
+        return true;
+    }
+
+    // Nearest snapshot at or before the index; the first one is at first_index, so there always is one
+    auto it = std::upper_bound(snapshots.cbegin(), snapshots.cend(), index,
+                               [](quint32 value, const Snapshot& snapshot) { return value < snapshot.index; });
+    --it;
+    return decodeState(it->state, state)
+        && replay(state, actions.constData() + (it->index - first_index), index - it->index);
+}
+
+QByteArray ActionLog::encodeSince(quint32 index) const
+{
+    // The receiver's state at a checkpoint or before it misses the change the checkpoint took over
+    if (index < first_index || index > endIndex() || index <= last_checkpoint) {
+        return QByteArray();
+    }
+
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << FORMAT_VERSION << index << false << actions.mid(index - first_index);
+    return bytes;
+}
+
+QByteArray ActionLog::encodeFromSnapshot() const
+{
+    const Snapshot& latest = snapshots.last();
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << FORMAT_VERSION << latest.index << true << latest.state << actions.mid(latest.index - first_index);
+    return bytes;
+}
+
+bool ActionLog::applyTail(const QByteArray& tail)
+{
+    QDataStream stream(tail);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint8 version = 0;
+    quint32 base_index = 0;
+    bool has_state = false;
+    QByteArray state_bytes;
+    QList<quint64> records;
+    stream >> version >> base_index >> has_state;
+    if (has_state) {
+        stream >> state_bytes;
+    }
+    stream >> records;
+    if (stream.status() != QDataStream::Ok || version != FORMAT_VERSION) {
+        return false;
+    }
+
+    GameState state;
+    if (has_state) {
+        if (!decodeState(state_bytes, state)) {
+            return false;
+        }
+    } else if (base_index != endIndex()) {
+        return false;
+    } else {
+        state = head_state;
+    }
+    // Check the whole tail before the log changes
+    GameState end_state = state;
+    if (!replay(end_state, records.constData(), records.size())) {
+        return false;
+    }
+
+    if (has_state) {
+        actions.clear();
+        snapshots = {{base_index, state_bytes}};
+        head_state = state;
+        first_index = base_index;
+        last_checkpoint = base_index;
+    }
+    for (quint64 record : std::as_const(records)) {
+        GameAction action;
+        GameAction::unpack(record, action);
+        append(action);
+    }
+    return true;
+}
+
+QByteArray ActionLog::encodeState(const GameState& state)
+{
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << TableCodec::encodeSnapshot(state.table) << state.turn;
+    return bytes;
+}
+
+bool ActionLog::decodeState(const QByteArray& bytes, GameState& state)
+{
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_6_0);
+    QByteArray table;
+    stream >> table >> state.turn;
+    return stream.status() == QDataStream::Ok && TableCodec::decodeSnapshot(table, state.table);
+}
+
+void ActionLog::snapshot()
+{
+    const Snapshot latest{endIndex(), encodeState(head_state)};
+    if (!snapshots.isEmpty() && snapshots.last().index == latest.index) {
+        snapshots.last() = latest;
+    } else {
+        snapshots.append(latest);
+    }
+}
+
+void ActionLog::compact()
+{
+    // The newest snapshot in the older half becomes the start of the log
+    const quint32 middle = first_index + quint32(actions.size() / 2);
+    auto it = std::upper_bound(snapshots.cbegin(), snapshots.cend(), middle,
+                               [](quint32 value, const Snapshot& snapshot) { return value < snapshot.index; });
+    const qsizetype dropped_snapshots = std::distance(snapshots.cbegin(), it) - 1;
+    if (dropped_snapshots <= 0) {
+        return;
+    }
+    const quint32 new_first = snapshots[dropped_snapshots].index;
+    actions.remove(0, new_first - first_index);
+    snapshots.remove(0, dropped_snapshots);
+    first_index = new_first;
+}
+
+bool ActionLog::replay(GameState& state, const quint64* records, qsizetype count)
+{
+    for (qsizetype i = 0; i < count; ++i) {
+        GameAction action;
+        if (!GameAction::unpack(records[i], action) || !GameRules::apply(state, action)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include "table_state.h"
+#include "turn_state.h"
+
+// Everything the action log rebuilds: who sits at the table and where the turn is
+struct GameState
+{
+    TableState table; // The sequence belongs to the table sync, not to the log, and is not maintained here
+    TurnState turn;
+};
+
+/*
+ * One recorded change of the game, packed into 64 bits: kind in bits 0-7, value (a TurnAction or PlayerStatus)
+ * in bits 8-15 and the acting player's id in bits 32-63. Kinds are stored, only append.
+ */
+struct GameAction
+{
+    enum class Kind : quint8 {
+        Turn,
+        PlayerStatus,
+        Count,
+    };
+
+    Kind kind = Kind::Turn;
+    quint8 value = 0;
+    quint32 player_id = 0;
+
+    static GameAction turn(quint32 player_id, TurnAction action);
+    static GameAction status(quint32 player_id, PlayerStatus status);
+
+    quint64 pack() const { return quint64(kind) | quint64(value) << 8 | quint64(player_id) << 32; }
+    static bool unpack(quint64 record, GameAction& action);
+};
+
+// How actions change a GameState; the server, the clients and replays all go through here
+class GameRules
+{
+public:
+    // Applies the action, false (state unchanged) when the player may not do it. Starting the game is not
+    // checked against the host, that is up to the caller
+    static bool apply(GameState& state, const GameAction& action);
+    static int seatOf(const TableState& table, quint32 player_id);
+};
+
+/*
+ * Append-only log of a game's actions with a snapshot of the state every SNAPSHOT_INTERVAL actions and at
+ * every checkpoint, for changes that are not actions (players joining and leaving). Any state in the retained
+ * range is the nearest snapshot before it plus at most SNAPSHOT_INTERVAL replayed actions.
+ *
+ * Actions are numbered from the start of the game. Once more than MAX_ACTIONS are retained, the oldest half is
+ * compacted away: its actions and snapshots are dropped and the oldest kept snapshot becomes the new start.
+ *
+ * Tails carry the log to another side: either the actions after an index the receiver already has, or the
+ * latest snapshot and the actions after it. Format (QDataStream, Qt_6_0): quint8 format version, quint32 base
+ * index, bool has state, state bytes if it has one, QList<quint64> packed actions.
+ */
+class ActionLog
+{
+public:
+    static constexpr quint8 FORMAT_VERSION = 1;
+    static constexpr int SNAPSHOT_INTERVAL = 64;
+    static constexpr int MAX_ACTIONS = 4096;
+
+    ActionLog();
+
+    // Empty log starting from a default GameState
+    void clear();
+    bool append(const GameAction& action);
+    // Takes over a state changed outside of actions and snapshots it
+    void checkpoint(const GameState& state);
+
+    const GameState& head() const { return head_state; }
+    quint32 firstIndex() const { return first_index; }
+    quint32 endIndex() const { return first_index + quint32(actions.size()); }
+    int snapshotCount() const { return snapshots.size(); }
+    // State after the first `index` actions, false when compacted away or not there yet
+    bool stateAt(quint32 index, GameState& state) const;
+
+    // Actions from index to the end, empty when index is not in the log or a checkpoint lies after it
+    QByteArray encodeSince(quint32 index) const;
+    // Latest snapshot and the actions after it, enough to rebuild the head from nothing
+    QByteArray encodeFromSnapshot() const;
+    // Continues or replaces the log with a tail; false (log unchanged) when it is malformed or does not follow
+    bool applyTail(const QByteArray& tail);
+
+    static QByteArray encodeState(const GameState& state);
+    static bool decodeState(const QByteArray& bytes, GameState& state);
+
+private:
+    struct Snapshot
+    {
+        quint32 index;    // Actions applied before it was taken
+        QByteArray state; // encodeState
+    };
+
+    QList<quint64> actions;    // Packed actions from first_index on
+    QList<Snapshot> snapshots; // Ascending, the first one at first_index
+    GameState head_state;
+    quint32 first_index = 0;
+    quint32 last_checkpoint = 0; // Index of the latest checkpoint, the start counts as one
+
+    void snapshot();
+    void compact();
+    static bool replay(GameState& state, const quint64* records, qsizetype count);
+};
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "deck_engine.h"
+
+// Pile implementation
+void Pile::reset(int capacity)
+{
+    int rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    slots.fill(NO_CARD, rounded);
+    head = 0;
+    count = 0;
+    mask = rounded - 1;
+}
+
+quint16 Pile::takeTop()
+{
+    if (count == 0) {
+        return NO_CARD;
+    }
+    const quint16 copy = slots[head];
+    head = (head + 1) & mask;
+    --count;
+    return copy;
+}
+
+quint16 Pile::takeBottom()
+{
+    if (count == 0) {
+        return NO_CARD;
+    }
+    --count;
+    return slots[slot(count)];
+}
+
+quint16 Pile::takeAt(int position)
+{
+    if (position < 0 || position >= count) {
+        return NO_CARD;
+    }
+    const quint16 copy = at(position);
+    slots[slot(position)] = at(count - 1);
+    --count;
+    return copy;
+}
+
+void Pile::putTop(quint16 copy)
+{
+    Q_ASSERT(count <= mask);
+    head = (head - 1) & mask;
+    slots[head] = copy;
+    ++count;
+}
+
+void Pile::putBottom(quint16 copy)
+{
+    Q_ASSERT(count <= mask);
+    slots[slot(count)] = copy;
+    ++count;
+}
+
+void Pile::shuffle(SeededRandom& random)
+{
+    // Over positions rather than slots, so the result does not depend on where the ring starts
+    random.shuffle(count, [this](int a, int b) { std::swap(slots[slot(a)], slots[slot(b)]); });
+}
+
+// DeckEngine implementation
+bool DeckEngine::reset(const QList<quint32>& crypt_cards, const QList<quint32>& library_cards, quint64 new_seed)
+{
+    const qsizetype total = crypt_cards.size() + library_cards.size();
+    cards.clear();
+    if (total > MAX_CARDS) {
+        for (Pile& pile : piles) {
+            pile.reset(0);
+        }
+        return false;
+    }
+
+    cards.reserve(total);
+    cards << crypt_cards << library_cards;
+    // Every pile can end up holding the whole deck
+    for (Pile& pile : piles) {
+        pile.reset(int(total));
+    }
+    for (int copy = 0; copy < crypt_cards.size(); ++copy) {
+        pileOf(Zone::Crypt).putBottom(quint16(copy));
+    }
+    for (int copy = int(crypt_cards.size()); copy < total; ++copy) {
+        pileOf(Zone::Library).putBottom(quint16(copy));
+    }
+
+    seed = new_seed;
+    random.reseed(seed);
+    shuffle(Zone::Crypt);
+    shuffle(Zone::Library);
+    for (int i = 0; i < OPENING_CRYPT; ++i) {
+        draw(Zone::Crypt, Zone::Uncontrolled);
+    }
+    for (int i = 0; i < OPENING_HAND; ++i) {
+        draw(Zone::Library, Zone::Hand);
+    }
+    return true;
+}
+
+quint64 DeckEngine::playerSeed(quint64 table_seed, quint32 player_id)
+{
+    return SeededRandom::derive(table_seed, player_id);
+}
+
+void DeckEngine::shuffle(Zone zone)
+{
+    pileOf(zone).shuffle(random);
+}
+
+quint16 DeckEngine::draw(Zone from, Zone to)
+{
+    const quint16 copy = pileOf(from).takeTop();
+    if (copy != Pile::NO_CARD) {
+        pileOf(to).putBottom(copy);
+    }
+    return copy;
+}
+
+quint16 DeckEngine::discard(int hand_position)
+{
+    const quint16 copy = pileOf(Zone::Hand).takeAt(hand_position);
+    if (copy != Pile::NO_CARD) {
+        pileOf(Zone::AshHeap).putTop(copy);
+    }
+    return copy;
+}
+
+quint16 DeckEngine::returnToPile(Zone from, int position, Zone pile, bool bottom)
+{
+    const quint16 copy = pileOf(from).takeAt(position);
+    if (copy != Pile::NO_CARD) {
+        if (bottom) {
+            pileOf(pile).putBottom(copy);
+        } else {
+            pileOf(pile).putTop(copy);
+        }
+    }
+    return copy;
+}
+
+quint64 DeckEngine::checksum() const
+{
+    constexpr quint64 FNV_OFFSET = 0xCBF29CE484222325ull;
+    constexpr quint64 FNV_PRIME = 0x100000001B3ull;
+
+    quint64 hash = FNV_OFFSET;
+    auto feed = [&hash](quint16 value) {
+        hash = (hash ^ (value & 0xFF)) * FNV_PRIME;
+        hash = (hash ^ (value >> 8)) * FNV_PRIME;
+    };
+    for (const Pile& zone : piles) {
+        // The size separates the zones, a card moving between neighbours changes the hash
+        feed(quint16(zone.size()));
+        for (int position = 0; position < zone.size(); ++position) {
+            feed(zone.at(position));
+        }
+    }
+    return hash;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QList>
+#include "seeded_random.h"
+
+/*
+ * An ordered pile of card copies, stored as 16 bit copy indices in a ring buffer sized for the whole deck, so
+ * taking from and putting on either end is O(1) and never allocates during a game. Position 0 is the top.
+ */
+class Pile
+{
+public:
+    static constexpr quint16 NO_CARD = 0xFFFF;
+
+    // Empties the pile and makes room for capacity copies
+    void reset(int capacity);
+
+    int size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    quint16 at(int position) const { return slots[slot(position)]; }
+
+    quint16 takeTop();
+    quint16 takeBottom();
+    // Takes a card out of the middle in O(1) by moving the bottom card into its place
+    quint16 takeAt(int position);
+    void putTop(quint16 copy);
+    void putBottom(quint16 copy);
+    void shuffle(SeededRandom& random);
+
+private:
+    QList<quint16> slots;
+    int head = 0;
+    int count = 0;
+    int mask = 0;
+
+    int slot(int position) const { return (head + position) & mask; }
+};
+
+/*
+ * Crypt, library, hand, uncontrolled region and ash heap of one player during a game. Cards are copies of the
+ * deck, numbered in the order reset() gets them; piles only hold those numbers and cardAt() maps them back to
+ * whatever the caller identifies cards by (a DeckModel row, a card id).
+ *
+ * All randomness comes from one SeededRandom seeded in reset(), so the same deck, seed and sequence of moves
+ * produce the same piles everywhere. The server hands out a seed instead of pile orders, and checksum() lets
+ * both sides compare the outcome.
+ */
+class DeckEngine
+{
+public:
+    enum class Zone : quint8 {
+        Crypt,
+        Library,
+        Hand,
+        Uncontrolled,
+        AshHeap,
+        Count,
+    };
+
+    static constexpr int OPENING_HAND = 7;
+    static constexpr int OPENING_CRYPT = 4;
+    static constexpr int MAX_CARDS = Pile::NO_CARD;
+
+    // Deals a new game: both decks shuffled, the opening hand drawn and the opening crypt cards uncontrolled.
+    // False (engine left empty) when the decks hold more than MAX_CARDS copies
+    bool reset(const QList<quint32>& crypt_cards, const QList<quint32>& library_cards, quint64 seed);
+
+    // Seed of a player's piles, derived from the seed the server sends to the whole table
+    static quint64 playerSeed(quint64 table_seed, quint32 player_id);
+
+    void shuffle(Zone zone);
+    // Moves the top card of a pile to the end of another, returns the copy or Pile::NO_CARD when it is empty
+    quint16 draw(Zone from = Zone::Library, Zone to = Zone::Hand);
+    // Hand card to the top of the ash heap
+    quint16 discard(int hand_position);
+    // Card of a zone back onto the top or bottom of a pile
+    quint16 returnToPile(Zone from, int position, Zone pile, bool bottom);
+
+    const Pile& pile(Zone zone) const { return piles[static_cast<int>(zone)]; }
+    int size(Zone zone) const { return pile(zone).size(); }
+    quint32 cardAt(quint16 copy) const { return cards[copy]; }
+    quint64 getSeed() const { return seed; }
+    // FNV-1a over the contents of every zone, in order
+    quint64 checksum() const;
+
+private:
+    QList<quint32> cards; // What each copy is, indexed by the copy numbers in the piles
+    Pile piles[static_cast<int>(Zone::Count)];
+    SeededRandom random;
+    quint64 seed = 0;
+
+    Pile& pileOf(Zone zone) { return piles[static_cast<int>(zone)]; }
+};
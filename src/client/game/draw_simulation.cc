@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "draw_simulation.h"
+#include "seeded_random.h"
+#include <QVarLengthArray>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Partial Fisher-Yates: the first `depth` positions end up a uniform random draw of the whole range
+template <typename T>
+void shuffleFront(T* cards, int size, int depth, SeededRandom& random)
+{
+    for (int i = 0; i < depth; ++i) {
+        std::swap(cards[i], cards[i + int(random.bounded(quint32(size - i)))]);
+    }
+}
+
+} // namespace
+
+// Tally implementation
+void DrawSimulation::Tally::add(const Tally& other)
+{
+    trials += other.trials;
+    for (int i = 0; i < MAX_QUERIES; ++i) {
+        hits[i] += other.hits[i];
+    }
+}
+
+double DrawSimulation::Tally::margin(int query) const
+{
+    if (trials == 0) {
+        return 1.0;
+    }
+    const double p = probability(query);
+    return 1.96 * std::sqrt(p * (1.0 - p) / double(trials));
+}
+
+// DrawSimulation implementation
+DrawSimulation::DrawSimulation(const Deck& deck, const QList<DrawQuery>& all_queries, quint64 seed)
+    : queries(all_queries.mid(0, MAX_QUERIES))
+    , crypt_cards(deck.crypt_cards)
+    , seed(seed)
+{
+    library_matches.reserve(deck.library_types.size());
+    for (int type : deck.library_types) {
+        quint32 matches = 0;
+        for (int q = 0; q < queries.size(); ++q) {
+            if (queries[q].pile == DrawQuery::Pile::Library && (type & queries[q].type_mask) != 0) {
+                matches |= 1u << q;
+            }
+        }
+        library_matches.append(matches);
+    }
+
+    for (const DrawQuery& query : std::as_const(queries)) {
+        int& depth = query.pile == DrawQuery::Pile::Library ? library_depth : crypt_depth;
+        depth = std::max(depth, query.draws);
+    }
+    library_depth = std::min(library_depth, int(library_matches.size()));
+    crypt_depth = std::min(crypt_depth, int(crypt_cards.size()));
+    for (quint16 card : std::as_const(crypt_cards)) {
+        crypt_card_count = std::max(crypt_card_count, card + 1);
+    }
+}
+
+DrawSimulation::Tally DrawSimulation::runChunk(quint64 chunk, int trials) const
+{
+    SeededRandom random(SeededRandom::derive(seed, chunk));
+    // The shuffles work on copies; leaving them shuffled between trials is fine, any start order is
+    QList<quint32> library = library_matches;
+    QList<quint16> crypt = crypt_cards;
+    const int query_count = queries.size();
+
+    QVarLengthArray<int, MAX_QUERIES> library_counts(query_count);
+    QVarLengthArray<int, 64> distinct_at(crypt_depth); // Different vampires among the first n + 1 crypt draws
+    QVarLengthArray<int, 256> seen_in_trial(crypt_card_count);
+    std::fill(seen_in_trial.begin(), seen_in_trial.end(), -1);
+
+    Tally tally;
+    tally.trials = quint64(trials);
+    for (int trial = 0; trial < trials; ++trial) {
+        shuffleFront(library.data(), int(library.size()), library_depth, random);
+        shuffleFront(crypt.data(), int(crypt.size()), crypt_depth, random);
+
+        std::fill(library_counts.begin(), library_counts.end(), 0);
+        for (int position = 0; position < library_depth; ++position) {
+            for (quint32 matches = library[position]; matches != 0; matches &= matches - 1) {
+                const int q = qCountTrailingZeroBits(matches);
+                if (position < queries[q].draws) {
+                    ++library_counts[q];
+                }
+            }
+        }
+        int distinct = 0;
+        for (int position = 0; position < crypt_depth; ++position) {
+            int& seen = seen_in_trial[crypt[position]];
+            if (seen != trial) {
+                seen = trial;
+                ++distinct;
+            }
+            distinct_at[position] = distinct;
+        }
+
+        for (int q = 0; q < query_count; ++q) {
+            const DrawQuery& query = queries[q];
+            int count = 0;
+            if (query.pile == DrawQuery::Pile::Library) {
+                count = library_counts[q];
+            } else if (crypt_depth > 0 && query.draws > 0) {
+                count = distinct_at[std::min(query.draws, crypt_depth) - 1];
+            }
+            if (count >= query.min_count) {
+                ++tally.hits[q];
+            }
+        }
+    }
+    return tally;
+}
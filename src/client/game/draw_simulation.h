@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <array>
+
+// One draw odds question, e.g. "at least 3 reactions in the first 7 library cards"
+struct DrawQuery
+{
+    enum class Pile : quint8 {
+        Library, // Counts copies whose type shares a bit with type_mask
+        Crypt,   // Counts different vampires
+    };
+
+    QString label;
+    Pile pile = Pile::Library;
+    int type_mask = 0; // Card::Type bits, library queries only
+    int min_count = 1;
+    int draws = 7;
+};
+
+/*
+ * Monte Carlo estimate of draw odds: shuffles the deck over and over and counts how often each query holds.
+ * Only the cards a query can look at are shuffled, a partial Fisher-Yates over the first `draws` positions,
+ * and every library copy carries a bit per query it counts for, so a trial costs O(draws) whatever the deck
+ * size.
+ *
+ * Trials run in chunks seeded by their index, so the totals over all chunks are the same however the chunks
+ * were spread over threads. runChunk() only reads the simulation and can run on any number of threads at once.
+ */
+class DrawSimulation
+{
+public:
+    static constexpr int MAX_QUERIES = 32;
+
+    // The deck as the simulation sees it: the Card::Type of every library copy, the card of every crypt copy
+    struct Deck
+    {
+        QList<int> library_types;
+        QList<quint16> crypt_cards;
+    };
+
+    struct Tally
+    {
+        quint64 trials = 0;
+        std::array<quint64, MAX_QUERIES> hits{};
+
+        void add(const Tally& other);
+        double probability(int query) const { return trials > 0 ? double(hits[query]) / trials : 0.0; }
+        // Half width of the 95% confidence interval of probability()
+        double margin(int query) const;
+    };
+
+    DrawSimulation() = default;
+    // Queries past MAX_QUERIES are ignored
+    DrawSimulation(const Deck& deck, const QList<DrawQuery>& queries, quint64 seed);
+
+    int queryCount() const { return queries.size(); }
+    Tally runChunk(quint64 chunk, int trials) const;
+
+private:
+    QList<DrawQuery> queries;
+    QList<quint32> library_matches; // Per library copy, bit q set when it counts for query q
+    QList<quint16> crypt_cards;
+    int library_depth = 0; // Positions any query looks at
+    int crypt_depth = 0;
+    int crypt_card_count = 0; // Different vampires, crypt_cards are below it
+    quint64 seed = 0;
+};
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QDataStream>
+#include <QString>
+
+// Open game as listed in the lobby; id is assigned by the server and stable for the game's lifetime
+struct GameInfo
+{
+    quint32 id = 0;
+    QString name;
+    QString host;
+    QString format;
+    int current_players = 0;
+    int max_players = 0;
+    int spectators = 0;
+    bool password_protected = false;
+    bool buddies_only = false;
+};
+
+// Wire format of GameInfo in protocol payloads, see networking/message.h
+inline QDataStream& operator<<(QDataStream& stream, const GameInfo& game)
+{
+    return stream << game.id << game.name << game.host << game.format << qint32(game.current_players)
+                  << qint32(game.max_players) << qint32(game.spectators) << game.password_protected
+                  << game.buddies_only;
+}
+
+inline QDataStream& operator>>(QDataStream& stream, GameInfo& game)
+{
+    qint32 current_players = 0;
+    qint32 max_players = 0;
+    qint32 spectators = 0;
+    stream >> game.id >> game.name >> game.host >> game.format >> current_players >> max_players >> spectators
+        >> game.password_protected >> game.buddies_only;
+    game.current_players = current_players;
+    game.max_players = max_players;
+    game.spectators = spectators;
+    return stream;
+}
@@ -7,13 +7,30 @@
 
 #include <QString>
 
+// Seat state of a player; the numeric values are part of the table state wire format, only append
+enum class PlayerStatus : quint8 {
+    Waiting,
+    SelectingDeck,
+    Ready,
+    Playing,
+    Conceded,
+    Ousted,
+    Disconnected,
+    Count,
+};
+
+QString playerStatusToString(PlayerStatus status);
+// Unknown names map to Waiting
+PlayerStatus playerStatusFromString(const QString& status);
+
 // Player in the game
 struct GamePlayer
 {
+    quint32 id = 0;      // Stable for the game, assigned by the server
     QString name;
-    QString status;      // Ready, Playing, Waiting, Disconnected, etc.
-    int life;
-    int hand_size;
-    bool is_host;
+    PlayerStatus status = PlayerStatus::Waiting;
+    int life = 0;        // Pool
+    int hand_size = 0;
+    bool is_host = false;
     QString avatar;
-};
\ No newline at end of file
+};
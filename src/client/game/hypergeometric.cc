@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "hypergeometric.h"
+#include <algorithm>
+
+namespace {
+
+// n choose k as a double, 0 outside 0 <= k <= n
+double choose(int n, int k)
+{
+    if (k < 0 || k > n) {
+        return 0.0;
+    }
+    k = std::min(k, n - k);
+    double result = 1.0;
+    for (int i = 1; i <= k; ++i) {
+        result = result * (n - k + i) / i;
+    }
+    return result;
+}
+
+bool isValid(int population, int successes, int draws)
+{
+    return population > 0 && successes >= 0 && successes <= population && draws >= 0 && draws <= population;
+}
+
+} // namespace
+
+namespace Hypergeometric {
+
+double probability(int population, int successes, int draws, int count)
+{
+    if (!isValid(population, successes, draws)) {
+        return 0.0;
+    }
+    return choose(successes, count) * choose(population - successes, draws - count) / choose(population, draws);
+}
+
+double atLeast(int population, int successes, int draws, int count)
+{
+    if (!isValid(population, successes, draws) || count > std::min(successes, draws)) {
+        return 0.0;
+    }
+    if (count <= 0) {
+        return 1.0;
+    }
+    if (count == 1) {
+        // 1 - P(none): the draws all come from the cards that do not count
+        double none = 1.0;
+        for (int i = 0; i < draws; ++i) {
+            none *= double(population - successes - i) / (population - i);
+        }
+        return 1.0 - none;
+    }
+
+    // Sum the shorter side of the distribution
+    double below = 0.0;
+    for (int k = 0; k < count; ++k) {
+        below += probability(population, successes, draws, k);
+    }
+    return std::clamp(1.0 - below, 0.0, 1.0);
+}
+
+double expected(int population, int successes, int draws)
+{
+    if (!isValid(population, successes, draws)) {
+        return 0.0;
+    }
+    return double(draws) * successes / population;
+}
+
+} // namespace Hypergeometric
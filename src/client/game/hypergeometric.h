@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+/*
+ * Exact odds of drawing without replacement: `draws` cards from a pile of `population`, `successes` of which
+ * count. Terms are built as running products rather than factorials, so they neither overflow nor lose precision
+ * at any deck size, and each costs O(draws).
+ */
+namespace Hypergeometric {
+
+// Chance of exactly `count` counting cards among the draws
+double probability(int population, int successes, int draws, int count);
+
+// Chance of `count` or more counting cards among the draws
+double atLeast(int population, int successes, int draws, int count);
+
+// Mean number of counting cards among the draws
+double expected(int population, int successes, int draws);
+
+} // namespace Hypergeometric
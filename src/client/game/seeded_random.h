@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include <utility>
+
+/*
+ * xoshiro128** generator seeded through splitmix64. It only uses fixed width integer arithmetic, so a seed gives
+ * the same sequence on every platform, desktop and wasm alike, which the standard library engines and
+ * distributions do not guarantee. Not meant for anything secret.
+ */
+class SeededRandom
+{
+public:
+    explicit SeededRandom(quint64 seed = 0) { reseed(seed); }
+
+    void reseed(quint64 seed)
+    {
+        for (quint32& word : state) {
+            seed += 0x9E3779B97F4A7C15ull;
+            word = quint32(mix(seed) >> 32);
+        }
+    }
+
+    quint32 next()
+    {
+        const quint32 result = rotl(state[1] * 5, 7) * 9;
+        const quint32 shifted = state[1] << 9;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= shifted;
+        state[3] = rotl(state[3], 11);
+        return result;
+    }
+
+    // Uniform in [0, range), Lemire's multiply and reject: a division only in the rare rejection case
+    quint32 bounded(quint32 range)
+    {
+        quint64 product = quint64(next()) * range;
+        quint32 low = quint32(product);
+        if (low < range) {
+            const quint32 threshold = (0u - range) % range;
+            while (low < threshold) {
+                product = quint64(next()) * range;
+                low = quint32(product);
+            }
+        }
+        return quint32(product >> 32);
+    }
+
+    // Fisher-Yates over any random access range
+    template <typename Swap>
+    void shuffle(int size, Swap swap)
+    {
+        for (int i = size - 1; i > 0; --i) {
+            swap(i, int(bounded(quint32(i + 1))));
+        }
+    }
+
+    template <typename T>
+    void shuffle(T* data, int size)
+    {
+        shuffle(size, [data](int a, int b) { std::swap(data[a], data[b]); });
+    }
+
+    // splitmix64 finalizer, also used to derive independent seeds from one, e.g. a seed per player
+    static quint64 mix(quint64 value)
+    {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    static quint64 derive(quint64 seed, quint64 stream) { return mix(seed + 0x9E3779B97F4A7C15ull * (stream + 1)); }
+
+private:
+    quint32 state[4];
+
+    static quint32 rotl(quint32 value, int bits) { return (value << bits) | (value >> (32 - bits)); }
+};
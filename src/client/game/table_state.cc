@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "table_state.h"
+#include <QHash>
+#include <QtEndian>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+constexpr const char* STATUS_NAMES[] = {
+    "Waiting", "Selecting Deck", "Ready", "Playing", "Conceded", "Ousted", "Disconnected",
+};
+static_assert(std::size(STATUS_NAMES) == static_cast<size_t>(PlayerStatus::Count), "Missing player status name");
+
+class Writer
+{
+public:
+    explicit Writer(QByteArray& bytes)
+        : bytes(bytes)
+    {
+    }
+
+    template <typename T>
+    void put(T value)
+    {
+        const qsizetype offset = bytes.size();
+        bytes.resize(offset + sizeof(T));
+        qToLittleEndian<T>(value, bytes.data() + offset);
+    }
+
+    template <typename Length>
+    void putString(const QString& text)
+    {
+        QByteArray utf8 = text.toUtf8();
+        utf8.truncate(std::numeric_limits<Length>::max());
+        put<Length>(Length(utf8.size()));
+        bytes.append(utf8);
+    }
+
+private:
+    QByteArray& bytes;
+};
+
+class Reader
+{
+public:
+    explicit Reader(const QByteArray& bytes)
+        : bytes(bytes)
+    {
+    }
+
+    template <typename T>
+    bool get(T& value)
+    {
+        if (bytes.size() - offset < qsizetype(sizeof(T))) {
+            return false;
+        }
+        value = qFromLittleEndian<T>(bytes.constData() + offset);
+        offset += sizeof(T);
+        return true;
+    }
+
+    template <typename Length>
+    bool getString(QString& text)
+    {
+        Length length = 0;
+        if (!get(length) || bytes.size() - offset < qsizetype(length)) {
+            return false;
+        }
+        text = QString::fromUtf8(bytes.constData() + offset, length);
+        offset += length;
+        return true;
+    }
+
+    bool atEnd() const { return offset == bytes.size(); }
+
+private:
+    const QByteArray& bytes;
+    qsizetype offset = 0;
+};
+
+bool readStatus(Reader& reader, PlayerStatus& status)
+{
+    quint8 value = 0;
+    if (!reader.get(value) || value >= static_cast<quint8>(PlayerStatus::Count)) {
+        return false;
+    }
+    status = static_cast<PlayerStatus>(value);
+    return true;
+}
+
+bool readLife(Reader& reader, int& life)
+{
+    qint16 value = 0;
+    if (!reader.get(value)) {
+        return false;
+    }
+    life = value;
+    return true;
+}
+
+bool readHandSize(Reader& reader, int& hand_size)
+{
+    quint8 value = 0;
+    if (!reader.get(value)) {
+        return false;
+    }
+    hand_size = value;
+    return true;
+}
+
+} // namespace
+
+QString playerStatusToString(PlayerStatus status)
+{
+    const size_t index = static_cast<size_t>(status);
+    return index < std::size(STATUS_NAMES) ? QString(STATUS_NAMES[index]) : QString("Unknown");
+}
+
+PlayerStatus playerStatusFromString(const QString& status)
+{
+    for (size_t i = 0; i < std::size(STATUS_NAMES); ++i) {
+        if (status == QLatin1String(STATUS_NAMES[i])) {
+            return static_cast<PlayerStatus>(i);
+        }
+    }
+    return PlayerStatus::Waiting;
+}
+
+QByteArray TableCodec::encodeSnapshot(const TableState& state)
+{
+    QByteArray bytes;
+    bytes.reserve(6 + state.players.size() * 48);
+    Writer writer(bytes);
+    writer.put<quint8>(FORMAT_VERSION);
+    writer.put<quint32>(state.sequence);
+    writer.put<quint8>(quint8(qMin<qsizetype>(state.players.size(), 255)));
+    for (qsizetype i = 0; i < qMin<qsizetype>(state.players.size(), 255); ++i) {
+        const GamePlayer& player = state.players[i];
+        writer.put<quint32>(player.id);
+        writer.put<quint8>(static_cast<quint8>(player.status));
+        writer.put<qint16>(qint16(player.life));
+        writer.put<quint8>(quint8(qBound(0, player.hand_size, 255)));
+        writer.put<quint8>(player.is_host ? 1 : 0);
+        writer.putString<quint8>(player.name);
+        writer.putString<quint16>(player.avatar);
+    }
+    return bytes;
+}
+
+bool TableCodec::decodeSnapshot(const QByteArray& bytes, TableState& state)
+{
+    Reader reader(bytes);
+    quint8 version = 0;
+    quint8 count = 0;
+    if (!reader.get(version) || version != FORMAT_VERSION || !reader.get(state.sequence) || !reader.get(count)) {
+        return false;
+    }
+
+    state.players.clear();
+    state.players.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        GamePlayer player;
+        quint8 flags = 0;
+        if (!reader.get(player.id) || !readStatus(reader, player.status) || !readLife(reader, player.life)
+            || !readHandSize(reader, player.hand_size) || !reader.get(flags)
+            || !reader.getString<quint8>(player.name) || !reader.getString<quint16>(player.avatar)) {
+            return false;
+        }
+        player.is_host = flags & 0x01;
+        state.players.append(player);
+    }
+    return reader.atEnd();
+}
+
+QByteArray TableCodec::encodeDelta(const TableDelta& delta)
+{
+    QByteArray bytes;
+    bytes.reserve(10 + delta.changes.size() * 9);
+    Writer writer(bytes);
+    writer.put<quint8>(FORMAT_VERSION);
+    writer.put<quint32>(delta.base_sequence);
+    writer.put<quint32>(delta.sequence);
+    writer.put<quint8>(quint8(qMin<qsizetype>(delta.changes.size(), 255)));
+    for (qsizetype i = 0; i < qMin<qsizetype>(delta.changes.size(), 255); ++i) {
+        const PlayerDelta& change = delta.changes[i];
+        writer.put<quint32>(change.player_id);
+        writer.put<quint8>(change.fields);
+        if (change.fields & PlayerDelta::StatusField)
+            writer.put<quint8>(static_cast<quint8>(change.status));
+        if (change.fields & PlayerDelta::LifeField)
+            writer.put<qint16>(qint16(change.life));
+        if (change.fields & PlayerDelta::HandSizeField)
+            writer.put<quint8>(quint8(qBound(0, change.hand_size, 255)));
+    }
+    return bytes;
+}
+
+bool TableCodec::decodeDelta(const QByteArray& bytes, TableDelta& delta)
+{
+    Reader reader(bytes);
+    quint8 version = 0;
+    quint8 count = 0;
+    if (!reader.get(version) || version != FORMAT_VERSION || !reader.get(delta.base_sequence)
+        || !reader.get(delta.sequence) || !reader.get(count)) {
+        return false;
+    }
+
+    delta.changes.clear();
+    delta.changes.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        PlayerDelta change;
+        if (!reader.get(change.player_id) || !reader.get(change.fields)) {
+            return false;
+        }
+        if ((change.fields & PlayerDelta::StatusField) && !readStatus(reader, change.status))
+            return false;
+        if ((change.fields & PlayerDelta::LifeField) && !readLife(reader, change.life))
+            return false;
+        if ((change.fields & PlayerDelta::HandSizeField) && !readHandSize(reader, change.hand_size))
+            return false;
+        delta.changes.append(change);
+    }
+    return reader.atEnd();
+}
+
+TableDelta TableCodec::diff(const TableState& from, const TableState& to)
+{
+    QHash<quint32, const GamePlayer*> previous;
+    previous.reserve(from.players.size());
+    for (const GamePlayer& player : from.players) {
+        previous.insert(player.id, &player);
+    }
+
+    TableDelta delta;
+    delta.base_sequence = from.sequence;
+    delta.sequence = to.sequence;
+    for (const GamePlayer& player : to.players) {
+        const GamePlayer* old_player = previous.value(player.id);
+        if (!old_player) {
+            continue;
+        }
+        PlayerDelta change;
+        change.player_id = player.id;
+        if (player.status != old_player->status) {
+            change.fields |= PlayerDelta::StatusField;
+            change.status = player.status;
+        }
+        if (player.life != old_player->life) {
+            change.fields |= PlayerDelta::LifeField;
+            change.life = player.life;
+        }
+        if (player.hand_size != old_player->hand_size) {
+            change.fields |= PlayerDelta::HandSizeField;
+            change.hand_size = player.hand_size;
+        }
+        if (change.fields != 0) {
+            delta.changes.append(change);
+        }
+    }
+    return delta;
+}
+
+bool TableCodec::apply(TableState& state, const TableDelta& delta)
+{
+    if (delta.base_sequence != state.sequence) {
+        return false;
+    }
+    for (const PlayerDelta& change : delta.changes) {
+        for (GamePlayer& player : state.players) {
+            if (player.id != change.player_id) {
+                continue;
+            }
+            if (change.fields & PlayerDelta::StatusField)
+                player.status = change.status;
+            if (change.fields & PlayerDelta::LifeField)
+                player.life = change.life;
+            if (change.fields & PlayerDelta::HandSizeField)
+                player.hand_size = change.hand_size;
+            break;
+        }
+    }
+    state.sequence = delta.sequence;
+    return true;
+}
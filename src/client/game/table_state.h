@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include "game_player.h"
+
+// Full state of a game table; sequence increases with every delta applied to it
+struct TableState
+{
+    quint32 sequence = 0;
+    QList<GamePlayer> players;
+};
+
+// Changed fields of one player, fields not flagged in `fields` are unused
+struct PlayerDelta
+{
+    enum Field : quint8 {
+        StatusField = 0x01,
+        LifeField = 0x02,
+        HandSizeField = 0x04,
+    };
+
+    quint32 player_id = 0;
+    quint8 fields = 0;
+    PlayerStatus status = PlayerStatus::Waiting;
+    int life = 0;
+    int hand_size = 0;
+};
+
+// Changes turning the table at base_sequence into the table at sequence
+struct TableDelta
+{
+    quint32 base_sequence = 0;
+    quint32 sequence = 0;
+    QList<PlayerDelta> changes;
+};
+
+/*
+ * Compact binary encoding of the table state, all integers little-endian:
+ *
+ *   Snapshot  quint8 format version, quint32 sequence, quint8 player count, then per player
+ *             quint32 id, quint8 status, qint16 life, quint8 hand size, quint8 flags (bit 0: host),
+ *             quint8 name length + UTF-8 name, quint16 avatar length + UTF-8 avatar URL
+ *   Delta     quint8 format version, quint32 base sequence, quint32 sequence, quint8 change count, then per change
+ *             quint32 player id, quint8 field mask, followed by only the flagged fields in mask bit order:
+ *             quint8 status, qint16 life, quint8 hand size
+ *
+ * A typical per-turn delta (pool and hand size of two players) is 31 bytes.
+ */
+class TableCodec
+{
+public:
+    static constexpr quint8 FORMAT_VERSION = 1;
+
+    static QByteArray encodeSnapshot(const TableState& state);
+    static bool decodeSnapshot(const QByteArray& bytes, TableState& state);
+    static QByteArray encodeDelta(const TableDelta& delta);
+    static bool decodeDelta(const QByteArray& bytes, TableDelta& delta);
+
+    // Field level differences between two states of the same table (players matched by id)
+    static TableDelta diff(const TableState& from, const TableState& to);
+    // Applies the changes of a delta to a state, false if the delta does not follow the state
+    static bool apply(TableState& state, const TableDelta& delta);
+};
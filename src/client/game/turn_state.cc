@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "turn_state.h"
+#include <QtAlgorithms>
+#include <iterator>
+
+namespace {
+
+constexpr int PHASE_COUNT = static_cast<int>(Phase::Count);
+constexpr int ACTION_COUNT = static_cast<int>(TurnAction::Count);
+
+constexpr const char* PHASE_NAMES[] = {"Setup", "Unlock", "Master", "Minion", "Influence", "Discard"};
+static_assert(std::size(PHASE_NAMES) == PHASE_COUNT, "Missing phase name");
+
+// What an action does in a phase: the phase it leads to (Count when not allowed) and whether the next seat
+// takes over
+struct Transition
+{
+    Phase next;
+    bool next_seat;
+};
+
+constexpr Transition INVALID = {Phase::Count, false};
+
+constexpr Transition TRANSITIONS[PHASE_COUNT][ACTION_COUNT] = {
+    /*               StartGame                NextPhase                  EndTurn */
+    /* Setup */     {{Phase::Unlock, false}, INVALID,                   INVALID},
+    /* Unlock */    {INVALID,                {Phase::Master, false},    {Phase::Unlock, true}},
+    /* Master */    {INVALID,                {Phase::Minion, false},    {Phase::Unlock, true}},
+    /* Minion */    {INVALID,                {Phase::Influence, false}, {Phase::Unlock, true}},
+    /* Influence */ {INVALID,                {Phase::Discard, false},   {Phase::Unlock, true}},
+    /* Discard */   {INVALID,                {Phase::Unlock, true},     {Phase::Unlock, true}},
+};
+
+const Transition& transition(const TurnState& state, TurnAction action)
+{
+    return TRANSITIONS[static_cast<int>(state.phase)][static_cast<int>(action)];
+}
+
+} // namespace
+
+QString phaseToString(Phase phase)
+{
+    const int index = static_cast<int>(phase);
+    return index < PHASE_COUNT ? QString(PHASE_NAMES[index]) : QString("Unknown");
+}
+
+bool TurnState::operator==(const TurnState& other) const
+{
+    return seat_count == other.seat_count && active_seat == other.active_seat && phase == other.phase
+        && turn == other.turn && ousted_mask == other.ousted_mask;
+}
+
+bool TurnMachine::canApply(const TurnState& state, TurnAction action)
+{
+    if (action >= TurnAction::Count || state.phase >= Phase::Count || state.seat_count == 0) {
+        return false;
+    }
+    return transition(state, action).next != Phase::Count;
+}
+
+bool TurnMachine::apply(TurnState& state, TurnAction action)
+{
+    if (!canApply(state, action)) {
+        return false;
+    }
+
+    const Transition& step = transition(state, action);
+    if (action == TurnAction::StartGame) {
+        state.active_seat = quint8(nextSeat(state, state.seat_count - 1));
+        state.turn = 1;
+    } else if (step.next_seat) {
+        state.active_seat = quint8(nextSeat(state, state.active_seat));
+        ++state.turn;
+    }
+    state.phase = step.next;
+    return true;
+}
+
+void TurnMachine::oust(TurnState& state, int seat)
+{
+    if (seat < 0 || seat >= state.seat_count || state.isOusted(seat)) {
+        return;
+    }
+    state.ousted_mask |= 1u << seat;
+    if (state.isStarted() && seat == state.active_seat) {
+        state.active_seat = quint8(nextSeat(state, seat));
+        state.phase = Phase::Unlock;
+        ++state.turn;
+    }
+}
+
+void TurnMachine::removeSeat(TurnState& state, int seat)
+{
+    if (seat < 0 || seat >= state.seat_count) {
+        return;
+    }
+    const bool was_active = state.isStarted() && seat == state.active_seat;
+    const quint32 below = (1u << seat) - 1;
+    state.ousted_mask = (state.ousted_mask & below) | ((state.ousted_mask >> 1) & ~below);
+    if (--state.seat_count == 0) {
+        state = TurnState();
+        return;
+    }
+    if (state.active_seat > seat) {
+        --state.active_seat;
+    }
+    if (was_active) {
+        // The next seat after the one before the removed seat is the seat that moved into its place
+        state.active_seat = quint8(nextSeat(state, seat > 0 ? seat - 1 : state.seat_count - 1));
+        state.phase = Phase::Unlock;
+        ++state.turn;
+    }
+}
+
+int TurnMachine::nextSeat(const TurnState& state, int seat)
+{
+    const quint32 seats = state.seat_count >= 32 ? ~0u : (1u << state.seat_count) - 1;
+    const quint32 remaining = seats & ~state.ousted_mask;
+    if (remaining == 0) {
+        return seat;
+    }
+    // Seats after this one first, then wrap around to the lowest one left
+    const quint32 after = seat >= 31 ? 0 : remaining & ~((2u << seat) - 1);
+    return int(qCountTrailingZeroBits(after != 0 ? after : remaining));
+}
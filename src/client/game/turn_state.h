@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QDataStream>
+#include <QString>
+
+// Phases of a VTES turn in play order, Setup before the game starts; values are on the wire, only append
+enum class Phase : quint8 {
+    Setup,
+    Unlock,
+    Master,
+    Minion,
+    Influence,
+    Discard,
+    Count,
+};
+
+// What a player can do to the turn; the active seat acts, StartGame is the host's
+enum class TurnAction : quint8 {
+    StartGame,
+    NextPhase,
+    EndTurn,
+    Count,
+};
+
+QString phaseToString(Phase phase);
+
+// Whose turn it is and where in it; seats are the players' positions at the table, in join order
+struct TurnState
+{
+    static constexpr int MAX_SEATS = 32;
+
+    quint8 seat_count = 0;
+    quint8 active_seat = 0;
+    Phase phase = Phase::Setup;
+    quint16 turn = 0;        // Counts from 1 once the game started
+    quint32 ousted_mask = 0; // Bit per seat that no longer takes turns
+
+    bool isStarted() const { return phase != Phase::Setup; }
+    bool isOusted(int seat) const { return ousted_mask & (1u << seat); }
+    bool operator==(const TurnState& other) const;
+    bool operator!=(const TurnState& other) const { return !(*this == other); }
+};
+
+/*
+ * Transitions of the turn, driven by a phase x action table so both the client and the server validate and
+ * apply actions the same way in constant time. The next seat skips ousted seats with bit operations.
+ */
+class TurnMachine
+{
+public:
+    static bool canApply(const TurnState& state, TurnAction action);
+    // Applies the action, false (state unchanged) when it is not allowed in the current phase
+    static bool apply(TurnState& state, TurnAction action);
+    // Marks a seat as ousted; if it was the active one, its turn ends
+    static void oust(TurnState& state, int seat);
+    // A player left the table: the seats after it move down one, and if it was the active seat the turn passes
+    // on to the player who sat after it
+    static void removeSeat(TurnState& state, int seat);
+    // Seat after the given one that is still in the game, the seat itself when it is the only one left
+    static int nextSeat(const TurnState& state, int seat);
+};
+
+// Wire format of TurnState in protocol payloads, see networking/message.h
+inline QDataStream& operator<<(QDataStream& stream, const TurnState& state)
+{
+    return stream << state.seat_count << state.active_seat << static_cast<quint8>(state.phase) << state.turn
+                  << state.ousted_mask;
+}
+
+inline QDataStream& operator>>(QDataStream& stream, TurnState& state)
+{
+    quint8 phase = 0;
+    stream >> state.seat_count >> state.active_seat >> phase >> state.turn >> state.ousted_mask;
+    if (phase >= static_cast<quint8>(Phase::Count) || state.seat_count > TurnState::MAX_SEATS
+        || (state.seat_count > 0 && state.active_seat >= state.seat_count)) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return stream;
+    }
+    state.phase = static_cast<Phase>(phase);
+    return stream;
+}
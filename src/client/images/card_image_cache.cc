@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "card_image_cache.h"
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QJSEngine>
+#include <QMutexLocker>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+const char* DEFAULT_SOURCE_URL = "https://static.krcg.org/card/";
+
+QImage decodeImage(const QByteArray& bytes, const QSize& size)
+{
+    QBuffer buffer;
+    buffer.setData(bytes);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer);
+    const QSize source_size = reader.size();
+    if (!source_size.isEmpty() && (size.width() > 0 || size.height() > 0)) {
+        // Let the decoder produce the display size directly; the JPEG plugin then skips most of the IDCT work
+        // and the full-size image never exists in memory. A zero dimension follows the aspect ratio.
+        QSize scaled_size = source_size;
+        if (size.width() <= 0) {
+            scaled_size = QSize(source_size.width() * size.height() / source_size.height(), size.height());
+        } else if (size.height() <= 0) {
+            scaled_size = QSize(size.width(), source_size.height() * size.width() / source_size.width());
+        } else {
+            scaled_size.scale(size, Qt::KeepAspectRatio);
+        }
+        if (scaled_size.width() < source_size.width()) {
+            reader.setScaledSize(scaled_size.expandedTo(QSize(1, 1)));
+        }
+    }
+    return reader.read();
+}
+
+} // namespace
+
+// CardImageCache implementation
+CardImageCache* CardImageCache::instance()
+{
+    static CardImageCache* cache = new CardImageCache(QCoreApplication::instance());
+    return cache;
+}
+
+CardImageCache* CardImageCache::create(QQmlEngine* qml_engine, QJSEngine* js_engine)
+{
+    Q_UNUSED(qml_engine)
+    Q_UNUSED(js_engine)
+    CardImageCache* cache = instance();
+    QJSEngine::setObjectOwnership(cache, QJSEngine::CppOwnership);
+    return cache;
+}
+
+CardImageCache::CardImageCache(QObject* parent)
+    : QObject(parent)
+    , network(new QNetworkAccessManager(this))
+{
+    QString source = qEnvironmentVariable("SCHRECKNET_CARD_IMAGE_URL", DEFAULT_SOURCE_URL);
+    if (!source.endsWith('/')) {
+        source += '/';
+    }
+    source_url = QUrl(source);
+
+    memory.setMaxCost(DEFAULT_MEMORY_LIMIT_KB);
+    cache_dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/cards";
+    QDir().mkpath(cache_dir);
+    scanDiskCache();
+}
+
+void CardImageCache::setDiskLimit(qint64 bytes)
+{
+    disk_limit = bytes;
+    evict();
+}
+
+QString CardImageCache::cacheKey(const QString& slug, const QSize& size)
+{
+    if (!size.isValid()) {
+        return slug;
+    }
+    return QString("%1@%2x%3").arg(slug).arg(size.width()).arg(size.height());
+}
+
+QImage CardImageCache::cachedImage(const QString& slug, const QSize& size)
+{
+    QMutexLocker locker(&memory_mutex);
+    const QImage* image = memory.object(cacheKey(slug, size));
+    if (!image) {
+        return QImage();
+    }
+    memory_hits.ref();
+    locker.unlock();
+    notifyStats();
+    return *image;
+}
+
+void CardImageCache::clearMemory()
+{
+    QMutexLocker locker(&memory_mutex);
+    memory.clear();
+    decoded_images.storeRelaxed(0);
+    decoded_bytes.storeRelaxed(0);
+    locker.unlock();
+    notifyStats();
+}
+
+bool CardImageCache::isValidSlug(const QString& slug)
+{
+    // Slugs end up in file paths and URLs, KRCG slugs are lowercase alphanumerics only
+    static const QRegularExpression slug_pattern("^[a-z0-9_-]{1,128}$");
+    return slug_pattern.match(slug).hasMatch();
+}
+
+void CardImageCache::requestImage(const QString& slug, const QSize& size)
+{
+    if (!isValidSlug(slug)) {
+        failures.ref();
+        notifyStats();
+        emit imageReady(cacheKey(slug, size), QImage(), QString("Invalid card image name %1").arg(slug));
+        return;
+    }
+
+    // Another request for the same card already reads or downloads the bytes, decode this size with it
+    auto it = pending.find(slug);
+    if (it != pending.end()) {
+        if (!it->contains(size)) {
+            it->append(size);
+        }
+        return;
+    }
+    pending.insert(slug, {size});
+
+    if (disk_entries.contains(slug)) {
+        disk_hits.ref();
+        touch(slug);
+        readFromDisk(slug);
+    } else {
+        misses.ref();
+        fetch(slug);
+    }
+    notifyStats();
+}
+
+void CardImageCache::readFromDisk(const QString& slug)
+{
+    const QString path = filePath(slug);
+    QtConcurrent::run([path]() {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return QByteArray();
+        }
+        // Refresh the modification time, which orders the LRU again after a restart. Setting it does not need
+        // write access to the file, and a cache that cannot be touched still serves the hit
+        file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+        return file.readAll();
+    }).then(this, [this, slug](const QByteArray& bytes) {
+        if (bytes.isEmpty()) {
+            // The file vanished behind our back, drop the entry and go to the network instead
+            disk_usage -= disk_entries.value(slug).size;
+            disk_order.remove(disk_entries.value(slug).tick);
+            disk_entries.remove(slug);
+            fetch(slug);
+            return;
+        }
+        decodePending(slug, bytes);
+    });
+}
+
+void CardImageCache::fetch(const QString& slug)
+{
+    QNetworkReply* reply = network->get(QNetworkRequest(source_url.resolved(QUrl(slug + ".jpg"))));
+    connect(reply, &QNetworkReply::finished, this, [this, reply, slug]() {
+        reply->deleteLater();
+        const QByteArray bytes = reply->readAll();
+        if (reply->error() != QNetworkReply::NoError || bytes.isEmpty()) {
+            fail(slug, reply->errorString());
+            return;
+        }
+        storeOnDisk(slug, bytes);
+        decodePending(slug, bytes);
+    });
+}
+
+void CardImageCache::storeOnDisk(const QString& slug, const QByteArray& bytes)
+{
+    // Written to a temporary file and renamed, so readers never see a partial image under its cache name. The entry
+    // is only recorded once the file is complete; until then another request for the slug goes to the network.
+    const QString path = filePath(slug);
+    const qint64 size = bytes.size();
+    QThreadPool::globalInstance()->start([this, path, slug, size, bytes]() {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != size || !file.commit()) {
+            return;
+        }
+        QMetaObject::invokeMethod(
+            this,
+            [this, slug, size]() {
+                insertDiskEntry(slug, size);
+                evict();
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void CardImageCache::decodePending(const QString& slug, const QByteArray& bytes)
+{
+    const QList<QSize> sizes = pending.take(slug);
+    for (const QSize& size : sizes) {
+        QThreadPool::globalInstance()->start([this, slug, bytes, size]() {
+            const QImage image = decodeImage(bytes, size);
+            const QString key = cacheKey(slug, size);
+            if (image.isNull()) {
+                failures.ref();
+                notifyStats();
+                emit imageReady(key, QImage(), QString("Cannot decode image for %1").arg(slug));
+                return;
+            }
+
+            {
+                QMutexLocker locker(&memory_mutex);
+                memory.insert(key, new QImage(image), qMax<qsizetype>(1, image.sizeInBytes() / 1024));
+            }
+            decoded_images.ref();
+            decoded_bytes.fetchAndAddRelaxed(image.sizeInBytes());
+            notifyStats();
+            // Emitted from the pool thread, responses receive it queued in their own thread. Thumbnails this small
+            // are uploaded into the scene graph's shared texture atlas, so a deck is drawn with a few binds.
+            emit imageReady(key, image, QString());
+        });
+    }
+}
+
+void CardImageCache::fail(const QString& slug, const QString& error)
+{
+    failures.ref();
+    notifyStats();
+    const QList<QSize> sizes = pending.take(slug);
+    for (const QSize& size : sizes) {
+        emit imageReady(cacheKey(slug, size), QImage(), error);
+    }
+}
+
+void CardImageCache::scanDiskCache()
+{
+    // Rebuild the LRU order from the modification times, which touch() refreshes on every hit
+    QFileInfoList files = QDir(cache_dir).entryInfoList({"*.jpg"}, QDir::Files);
+    std::sort(files.begin(), files.end(), [](const QFileInfo& a, const QFileInfo& b) {
+        return a.lastModified() < b.lastModified();
+    });
+    for (const QFileInfo& info : std::as_const(files)) {
+        insertDiskEntry(info.completeBaseName(), info.size());
+    }
+    evict();
+}
+
+void CardImageCache::touch(const QString& slug)
+{
+    DiskEntry& entry = disk_entries[slug];
+    disk_order.remove(entry.tick);
+    entry.tick = next_tick++;
+    disk_order.insert(entry.tick, slug);
+}
+
+void CardImageCache::insertDiskEntry(const QString& slug, qint64 size)
+{
+    auto it = disk_entries.find(slug);
+    if (it != disk_entries.end()) {
+        disk_usage -= it->size;
+        disk_order.remove(it->tick);
+    }
+    DiskEntry entry{size, next_tick++};
+    disk_entries.insert(slug, entry);
+    disk_order.insert(entry.tick, slug);
+    disk_usage += size;
+}
+
+void CardImageCache::evict()
+{
+    while (disk_usage > disk_limit && !disk_order.isEmpty()) {
+        const QString slug = disk_order.take(disk_order.firstKey());
+        disk_usage -= disk_entries.take(slug).size;
+        QFile::remove(filePath(slug));
+    }
+    notifyStats();
+}
+
+QString CardImageCache::filePath(const QString& slug) const
+{
+    return cache_dir + '/' + slug + ".jpg";
+}
+
+void CardImageCache::notifyStats()
+{
+    // Counters change on loader and pool threads, QML only ever sees the signal on the GUI thread
+    QMetaObject::invokeMethod(this, &CardImageCache::statsChanged, Qt::QueuedConnection);
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QAtomicInt>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QSize>
+#include <QUrl>
+#include <qqmlregistration.h>
+
+class QJSEngine;
+class QNetworkAccessManager;
+class QQmlEngine;
+
+/*
+ * Two-tier card image cache behind the "image://cards/<slug>" provider.
+ *
+ * Tier 1 is an in-memory cache of decoded images, safe to query from the image loader threads.
+ * Tier 2 is a size-bounded on-disk LRU of the original JPEG bytes, keyed by card slug, that survives restarts.
+ * Misses are fetched from the image source (the KRCG CDN, or a local fixture directory through a file: URL set in
+ * SCHRECKNET_CARD_IMAGE_URL). Disk reads, writes and decoding run on the thread pool; bookkeeping stays on the
+ * GUI thread.
+ */
+class CardImageCache : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+    Q_PROPERTY(int memoryHits READ getMemoryHits NOTIFY statsChanged)
+    Q_PROPERTY(int diskHits READ getDiskHits NOTIFY statsChanged)
+    Q_PROPERTY(int misses READ getMisses NOTIFY statsChanged)
+    Q_PROPERTY(int failures READ getFailures NOTIFY statsChanged)
+    Q_PROPERTY(qint64 diskUsage READ getDiskUsage NOTIFY statsChanged)
+    // Images decoded since the memory tier was last cleared and their size in memory; clearing it and opening
+    // a deck gives what drawing that deck costs
+    Q_PROPERTY(int decodedImages READ getDecodedImages NOTIFY statsChanged)
+    Q_PROPERTY(qint64 decodedBytes READ getDecodedBytes NOTIFY statsChanged)
+
+public:
+    static constexpr qint64 DEFAULT_DISK_LIMIT = 256 * 1024 * 1024;
+    static constexpr int DEFAULT_MEMORY_LIMIT_KB = 64 * 1024;
+
+    static CardImageCache* instance();
+    static CardImageCache* create(QQmlEngine* qml_engine, QJSEngine* js_engine);
+
+    int getMemoryHits() const { return memory_hits.loadRelaxed(); }
+    int getDiskHits() const { return disk_hits.loadRelaxed(); }
+    int getMisses() const { return misses.loadRelaxed(); }
+    int getFailures() const { return failures.loadRelaxed(); }
+    qint64 getDiskUsage() const { return disk_usage; }
+    int getDecodedImages() const { return decoded_images.loadRelaxed(); }
+    qint64 getDecodedBytes() const { return decoded_bytes.loadRelaxed(); }
+
+    void setSourceUrl(const QUrl& url) { source_url = url; }
+    void setDiskLimit(qint64 bytes);
+
+    // Thread safe; returns a null image when the decoded image is not in memory
+    QImage cachedImage(const QString& slug, const QSize& size);
+    static QString cacheKey(const QString& slug, const QSize& size);
+    static bool isValidSlug(const QString& slug);
+
+public slots:
+    // Resolves an image through the disk and network tiers, answered through imageReady
+    void requestImage(const QString& slug, const QSize& size);
+    Q_INVOKABLE void clearMemory();
+
+signals:
+    void imageReady(const QString& key, const QImage& image, const QString& error);
+    void statsChanged();
+
+private:
+    explicit CardImageCache(QObject* parent = nullptr);
+
+    struct DiskEntry
+    {
+        qint64 size = 0;
+        quint64 tick = 0;
+    };
+
+    QUrl source_url;
+    QString cache_dir;
+    qint64 disk_limit = DEFAULT_DISK_LIMIT;
+    qint64 disk_usage = 0;
+
+    // LRU bookkeeping of the disk tier, GUI thread only
+    QHash<QString, DiskEntry> disk_entries;
+    QMap<quint64, QString> disk_order;
+    quint64 next_tick = 0;
+
+    // Requested sizes waiting on a disk read or download, by slug
+    QHash<QString, QList<QSize>> pending;
+
+    QMutex memory_mutex;
+    QCache<QString, QImage> memory;
+
+    QAtomicInt memory_hits;
+    QAtomicInt disk_hits;
+    QAtomicInt misses;
+    QAtomicInt failures;
+    QAtomicInt decoded_images;
+    QAtomicInteger<qint64> decoded_bytes;
+
+    QNetworkAccessManager* network = nullptr;
+
+    void scanDiskCache();
+    void touch(const QString& slug);
+    void insertDiskEntry(const QString& slug, qint64 size);
+    void evict();
+    QString filePath(const QString& slug) const;
+    void readFromDisk(const QString& slug);
+    void fetch(const QString& slug);
+    void storeOnDisk(const QString& slug, const QByteArray& bytes);
+    void decodePending(const QString& slug, const QByteArray& bytes);
+    void fail(const QString& slug, const QString& error);
+    void notifyStats();
+};
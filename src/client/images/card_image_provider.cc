@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "card_image_provider.h"
+#include "card_image_cache.h"
+
+// CardImageResponse implementation
+CardImageResponse::CardImageResponse(CardImageCache* cache, const QString& slug, const QSize& requested_size)
+    : key(CardImageCache::cacheKey(slug, requested_size))
+{
+    image = cache->cachedImage(slug, requested_size);
+    if (!image.isNull()) {
+        // The loader connects to finished() after this returns, so report the memory hit queued
+        QMetaObject::invokeMethod(this, &QQuickImageResponse::finished, Qt::QueuedConnection);
+        return;
+    }
+
+    connection = connect(cache, &CardImageCache::imageReady, this, &CardImageResponse::onImageReady);
+    QMetaObject::invokeMethod(
+        cache, [cache, slug, requested_size]() { cache->requestImage(slug, requested_size); }, Qt::QueuedConnection);
+}
+
+QQuickTextureFactory* CardImageResponse::textureFactory() const
+{
+    return QQuickTextureFactory::textureFactoryForImage(image);
+}
+
+void CardImageResponse::onImageReady(const QString& image_key, const QImage& ready_image, const QString& image_error)
+{
+    if (image_key != key) {
+        return;
+    }
+    disconnect(connection);
+    image = ready_image;
+    error = image_error;
+    emit finished();
+}
+
+// CardImageProvider implementation
+CardImageProvider::CardImageProvider(CardImageCache* cache)
+    : cache(cache)
+{
+}
+
+QQuickImageResponse* CardImageProvider::requestImageResponse(const QString& id, const QSize& requested_size)
+{
+    return new CardImageResponse(cache, id, requested_size);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QImage>
+#include <QQuickAsyncImageProvider>
+#include <QQuickImageResponse>
+#include <QSize>
+#include <QString>
+
+class CardImageCache;
+
+// Response for a single "image://cards/<slug>" request, answered by CardImageCache
+class CardImageResponse : public QQuickImageResponse
+{
+    Q_OBJECT
+
+public:
+    CardImageResponse(CardImageCache* cache, const QString& slug, const QSize& requested_size);
+
+    QQuickTextureFactory* textureFactory() const override;
+    QString errorString() const override { return error; }
+
+private:
+    QString key;
+    QImage image;
+    QString error;
+    QMetaObject::Connection connection;
+
+    void onImageReady(const QString& image_key, const QImage& ready_image, const QString& image_error);
+};
+
+// Serves card images from CardImageCache, e.g. Image { source: "image://cards/howler" }
+class CardImageProvider : public QQuickAsyncImageProvider
+{
+public:
+    explicit CardImageProvider(CardImageCache* cache);
+
+    QQuickImageResponse* requestImageResponse(const QString& id, const QSize& requested_size) override;
+
+private:
+    CardImageCache* cache;
+};
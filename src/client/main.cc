@@ -11,6 +11,8 @@
 #include "controllers/login_controller.h"
 #include "controllers/game_lobby_controller.h"
 #include "controllers/game_controller.h"
+#include "images/card_image_cache.h"
+#include "images/card_image_provider.h"
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -33,6 +35,7 @@ int main(int argc, char* argv[])
 #endif
 
     QQmlApplicationEngine engine;
+    engine.addImageProvider("cards", new CardImageProvider(CardImageCache::instance()));
     
     // Handle object creation failures
     QObject::connect(
@@ -4,88 +4,152 @@
  */
 
 #include "card.h"
+#include <QHash>
 #include <QStringList>
+#include <array>
+
+namespace {
+
+constexpr int TYPE_BIT_COUNT = 13;
+constexpr int TYPE_MASK_COUNT = 1 << TYPE_BIT_COUNT;
+constexpr quint8 INVALID_SLOT = 0xFF;
+
+// Display names per type bit, in bit order; combined types are joined with "/"
+constexpr const char* TYPE_BIT_NAMES[TYPE_BIT_COUNT] = {
+    "Crypt", "Master", "Action", "Modifier", "Political Action", "Equipment", "Retainer",
+    "Ally", "Combat", "Reaction", "Event", "Power", "Conviction",
+};
+
+// Only these types are printed together on VTES cards (e.g. "Modifier/Combat", "Combat/Reaction")
+constexpr int COMBINABLE_TYPES = static_cast<int>(Card::Type::Action) | static_cast<int>(Card::Type::ActionModifier)
+                               | static_cast<int>(Card::Type::Combat) | static_cast<int>(Card::Type::Reaction);
+
+constexpr bool isValidTypeMask(int mask)
+{
+    const bool single_type = (mask & (mask - 1)) == 0;
+    return single_type || (mask & ~COMBINABLE_TYPES) == 0;
+}
+
+// Compile-time mask -> slot table over all valid type combinations; slot 0 is Token ("Unknown")
+struct TypeSlotTable
+{
+    std::array<quint8, TYPE_MASK_COUNT> slots{};
+    std::array<quint16, TYPE_MASK_COUNT> masks{};
+    int count = 0;
+};
+
+constexpr TypeSlotTable TYPE_SLOTS = []() {
+    TypeSlotTable table;
+    for (int mask = 0; mask < TYPE_MASK_COUNT; ++mask) {
+        if (isValidTypeMask(mask)) {
+            table.masks[table.count] = quint16(mask);
+            table.slots[mask] = quint8(table.count++);
+        } else {
+            table.slots[mask] = INVALID_SLOT;
+        }
+    }
+    return table;
+}();
+
+static_assert(TYPE_SLOTS.count < INVALID_SLOT, "Type slots must fit in a byte");
+
+// Must match DISCIPLINES in meta/build_card_db.py, the bit of a discipline is its index
+constexpr const char* DISCIPLINE_NAMES[Card::DISCIPLINE_COUNT] = {
+    "Abombwe", "Animalism", "Auspex", "Celerity", "Chimerstry", "Daimoinon", "Dementation", "Dominate",
+    "Flight", "Fortitude", "Melpominee", "Mytherceria", "Necromancy", "Obeah", "Obfuscate", "Oblivion",
+    "Obtenebration", "Potence", "Presence", "Protean", "Quietus", "Sanguinus", "Serpentis", "Spiritus",
+    "Striga", "Temporis", "Thaumaturgy", "Thanatosis", "Valeren", "Vicissitude", "Visceratika", "Maleficia",
+    "Defense", "Innocence", "Judgment", "Martyrdom", "Redemption", "Vengeance", "Vision",
+};
+
+static_assert(Card::DISCIPLINE_COUNT <= 64, "Disciplines must fit in a 64-bit mask");
+
+QString joinTypeNames(int mask)
+{
+    QStringList type_strings;
+    for (int bit = 0; bit < TYPE_BIT_COUNT; ++bit) {
+        if (mask & (1 << bit)) {
+            type_strings << QString::fromLatin1(TYPE_BIT_NAMES[bit]);
+        }
+    }
+
+    // Handle special cases
+    if (type_strings.isEmpty())
+        return "Unknown";
+
+    // Join multiple types with "/"
+    return type_strings.join("/");
+}
+
+// Interned names for every valid combination, built once; copies share the same string data
+const QList<QString>& typeNames()
+{
+    static const QList<QString> names = []() {
+        QList<QString> list;
+        list.reserve(TYPE_SLOTS.count);
+        for (int slot = 0; slot < TYPE_SLOTS.count; ++slot) {
+            list.append(joinTypeNames(TYPE_SLOTS.masks[slot]));
+        }
+        return list;
+    }();
+    return names;
+}
+
+const QHash<QString, Card::Type>& typesByName()
+{
+    static const QHash<QString, Card::Type> types = []() {
+        QHash<QString, Card::Type> hash;
+        const QList<QString>& names = typeNames();
+        hash.reserve(names.size());
+        // Slot 0 is "Unknown", which should keep mapping to Token through the fallback
+        for (int slot = 1; slot < names.size(); ++slot) {
+            hash.insert(names[slot], static_cast<Card::Type>(TYPE_SLOTS.masks[slot]));
+        }
+        return hash;
+    }();
+    return types;
+}
+
+} // namespace
 
 // Card utility functions implementation
-QString Card::cardTypeToString(Card::Type type) {
-  QStringList type_strings;
-
-  // Check each flag and add corresponding string
-  if (static_cast<int>(type) & static_cast<int>(Type::Crypt))
-    type_strings << "Crypt";
-  if (static_cast<int>(type) & static_cast<int>(Type::Master))
-    type_strings << "Master";
-  if (static_cast<int>(type) & static_cast<int>(Type::Action))
-    type_strings << "Action";
-  if (static_cast<int>(type) & static_cast<int>(Type::ActionModifier))
-    type_strings << "Modifier";
-  if (static_cast<int>(type) & static_cast<int>(Type::PoliticalAction))
-    type_strings << "Political Action";
-  if (static_cast<int>(type) & static_cast<int>(Type::Equipment))
-    type_strings << "Equipment";
-  if (static_cast<int>(type) & static_cast<int>(Type::Retainer))
-    type_strings << "Retainer";
-  if (static_cast<int>(type) & static_cast<int>(Type::Ally))
-    type_strings << "Ally";
-  if (static_cast<int>(type) & static_cast<int>(Type::Combat))
-    type_strings << "Combat";
-  if (static_cast<int>(type) & static_cast<int>(Type::Reaction))
-    type_strings << "Reaction";
-  if (static_cast<int>(type) & static_cast<int>(Type::Event))
-    type_strings << "Event";
-  if (static_cast<int>(type) & static_cast<int>(Type::Power))
-    type_strings << "Power";
-  if (static_cast<int>(type) & static_cast<int>(Type::Conviction))
-    type_strings << "Conviction";
-
-  // Handle special cases
-  if (type_strings.isEmpty())
-    return "Unknown";
-
-  // Join multiple types with "/"
-  return type_strings.join("/");
+QString Card::cardTypeToString(Card::Type type)
+{
+    const int mask = static_cast<int>(type);
+    const quint8 slot = mask >= 0 && mask < TYPE_MASK_COUNT ? TYPE_SLOTS.slots[mask] : INVALID_SLOT;
+    if (slot != INVALID_SLOT) {
+        return typeNames()[slot];
+    }
+
+    // Combinations that never appear on real cards are built on demand
+    return joinTypeNames(mask & (TYPE_MASK_COUNT - 1));
 }
 
-Card::Type Card::stringToCardType(const QString &typeStr) {
-  // Handle single types first
-  if (typeStr == "Crypt")
-    return static_cast<Type>(static_cast<int>(Type::Crypt));
-  if (typeStr == "Master")
-    return static_cast<Type>(static_cast<int>(Type::Master));
-  if (typeStr == "Action")
-    return static_cast<Type>(static_cast<int>(Type::Action));
-  if (typeStr == "Modifier")
-    return static_cast<Type>(static_cast<int>(Type::ActionModifier));
-  if (typeStr == "Political Action")
-    return static_cast<Type>(static_cast<int>(Type::PoliticalAction));
-  if (typeStr == "Equipment")
-    return static_cast<Type>(static_cast<int>(Type::Equipment));
-  if (typeStr == "Retainer")
-    return static_cast<Type>(static_cast<int>(Type::Retainer));
-  if (typeStr == "Ally")
-    return static_cast<Type>(static_cast<int>(Type::Ally));
-  if (typeStr == "Combat")
-    return static_cast<Type>(static_cast<int>(Type::Combat));
-  if (typeStr == "Reaction")
-    return static_cast<Type>(static_cast<int>(Type::Reaction));
-  if (typeStr == "Event")
-    return static_cast<Type>(static_cast<int>(Type::Event));
-  if (typeStr == "Power")
-    return static_cast<Type>(static_cast<int>(Type::Power));
-  if (typeStr == "Conviction")
-    return static_cast<Type>(static_cast<int>(Type::Conviction));
-
-  // Handle compound types (e.g., "Action/Combat")
-  if (typeStr.contains("/")) {
-    QStringList parts = typeStr.split("/");
-    int combinedType = 0;
-    for (const QString &part : parts) {
-      Card::Type partType = stringToCardType(part.trimmed());
-      combinedType |= static_cast<int>(partType);
+Card::Type Card::stringToCardType(const QString& typeStr)
+{
+    const auto& types = typesByName();
+    const auto it = types.constFind(typeStr);
+    if (it != types.constEnd()) {
+        return it.value();
+    }
+
+    // Handle compound types in a different order or with spacing (e.g., "Combat / Modifier")
+    if (typeStr.contains('/')) {
+        int combined_type = 0;
+        for (const QStringView part : QStringView(typeStr).split('/')) {
+            combined_type |= static_cast<int>(types.value(part.trimmed().toString(), Type::Token));
+        }
+        return static_cast<Type>(combined_type);
     }
-    return static_cast<Type>(combinedType);
-  }
 
-  // Default to Token for unknown types
-  return Type::Token;
-}
\ No newline at end of file
+    // Default to Token for unknown types
+    return Type::Token;
+}
+
+QString Card::disciplineName(int discipline)
+{
+    if (discipline < 0 || discipline >= DISCIPLINE_COUNT) {
+        return QString();
+    }
+    return QString::fromLatin1(DISCIPLINE_NAMES[discipline]);
+}
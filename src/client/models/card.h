@@ -6,6 +6,7 @@
 #pragma once
 
 #include <QString>
+#include <QtGlobal>
 
 // Card class for VTEs cards
 class Card
@@ -29,32 +30,59 @@ public:
         Conviction      = 0x1000,
     };
 
+    // Disciplines in the order of their bit in disciplines(); must match DISCIPLINES in meta/build_card_db.py
+    static constexpr int DISCIPLINE_COUNT = 39;
+
     Card() = default;
     Card(const QString& name, Type type, const QString& image_url)
-        : name(name), type(type), image_url(image_url) {}
+        : name(name), type(type), image_url(image_url), image_slug(slugFromImageUrl(image_url)) {}
 
     // Getters
+    quint32 getId() const { return id; }
     QString getName() const { return name; }
     Type getType() const { return type; }
     QString typeString() const { return cardTypeToString(type); }
+    bool isCrypt() const { return (static_cast<int>(type) & static_cast<int>(Type::Crypt)) != 0; }
+    QString getText() const { return text; }
     QString getImageUrl() const { return image_url; }
+    QString getImageSlug() const { return image_slug; }
     int getQuantity() const { return quantity; }
+    int getCapacity() const { return capacity; }
+    quint64 getDisciplines() const { return disciplines; }
+    quint64 getSuperiorDisciplines() const { return superior_disciplines; }
 
     // Setters
+    void setId(quint32 id_) { id = id_; }
     void setName(const QString& name_) { name = name_; }
     void setType(Type type_) { type = type_; }
-    void setImageUrl(const QString& url) { image_url = url; }
+    void setText(const QString& text_) { text = text_; }
+    void setImageUrl(const QString& url) { image_url = url; image_slug = slugFromImageUrl(url); }
     void setQuantity(int quantity_) { quantity = quantity_; }
+    void setCapacity(int capacity_) { capacity = capacity_; }
+    void setDisciplines(quint64 disciplines_, quint64 superior_)
+    {
+        disciplines = disciplines_ | superior_;
+        superior_disciplines = superior_;
+    }
 
     // Utility functions
     static QString cardTypeToString(Type type);
     static Type stringToCardType(const QString& typeStr);
+    // "Auspex" for the bit of "aus"; empty past DISCIPLINE_COUNT
+    static QString disciplineName(int discipline);
+    // "https://static.krcg.org/card/howler.jpg" -> "howler", the key of the card image cache
+    static QString slugFromImageUrl(const QString& url) { return url.section('/', -1).section('.', 0, 0); }
 
 private:
+    quint32 id = 0; // VTES card id, 0 for cards that are not in the card database
     QString name;
     Type type = Type::Token;
     QString text;
     // Todo; add rulings. contains of a list of rules with 'refs'. and each 'ref' contains an id and a url.
     QString image_url;
+    QString image_slug;
     int quantity = 0;
+    int capacity = 0;                  // Vampires and imbued only
+    quint64 disciplines = 0;           // Bit per discipline at any level; required ones for library cards
+    quint64 superior_disciplines = 0;  // Crypt cards only, a subset of disciplines
 };
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "card_copy_model.h"
+#include <algorithm>
+
+// CardCopyModel implementation
+CardCopyModel::CardCopyModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+void CardCopyModel::setSourceModel(QAbstractItemModel* model)
+{
+    if (source == model) {
+        return;
+    }
+
+    beginResetModel();
+    if (source) {
+        disconnect(source, nullptr, this, nullptr);
+    }
+    source = model;
+    if (source) {
+        quantity_role = source->roleNames().key("quantity", -1);
+        connect(source, &QAbstractItemModel::rowsInserted, this, &CardCopyModel::onRowsInserted);
+        connect(source, &QAbstractItemModel::rowsAboutToBeRemoved, this, &CardCopyModel::onRowsAboutToBeRemoved);
+        connect(source, &QAbstractItemModel::rowsRemoved, this, &CardCopyModel::onRowsRemoved);
+        connect(source, &QAbstractItemModel::dataChanged, this, &CardCopyModel::onDataChanged);
+        connect(source, &QAbstractItemModel::modelAboutToBeReset, this, &CardCopyModel::beginResetModel);
+        connect(source, &QAbstractItemModel::modelReset, this, &CardCopyModel::onReset);
+        connect(source, &QAbstractItemModel::layoutAboutToBeChanged, this, &CardCopyModel::beginResetModel);
+        connect(source, &QAbstractItemModel::layoutChanged, this, &CardCopyModel::onReset);
+        // The QPointer is already null here, so setSourceModel(nullptr) would return early
+        connect(source, &QObject::destroyed, this, [this]() {
+            beginResetModel();
+            quantity_role = -1;
+            offsets = {0};
+            endResetModel();
+            emit sourceModelChanged();
+            emit countChanged();
+        });
+    }
+    rebuildOffsets();
+    endResetModel();
+
+    emit sourceModelChanged();
+    emit countChanged();
+}
+
+int CardCopyModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent)
+    return offsets.last();
+}
+
+int CardCopyModel::sourceRow(int copy_row) const
+{
+    if (copy_row < 0 || copy_row >= offsets.last()) {
+        return -1;
+    }
+    // First offset past the copy, the entry before it holds the copy
+    return int(std::upper_bound(offsets.cbegin(), offsets.cend(), copy_row) - offsets.cbegin()) - 1;
+}
+
+QVariant CardCopyModel::data(const QModelIndex& index, int role) const
+{
+    const int source_row = index.isValid() ? sourceRow(index.row()) : -1;
+    if (source_row < 0) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case CopyIndexRole:
+        return index.row() - offsets[source_row];
+    case SourceRowRole:
+        return source_row;
+    }
+    return source->index(source_row, 0).data(role);
+}
+
+QHash<int, QByteArray> CardCopyModel::roleNames() const
+{
+    QHash<int, QByteArray> roles = source ? source->roleNames() : QHash<int, QByteArray>();
+    roles[CopyIndexRole] = "copyIndex";
+    roles[SourceRowRole] = "sourceRow";
+    return roles;
+}
+
+int CardCopyModel::quantityAt(int source_row) const
+{
+    if (quantity_role < 0) {
+        return 1;
+    }
+    return std::max(0, source->index(source_row, 0).data(quantity_role).toInt());
+}
+
+void CardCopyModel::rebuildOffsets()
+{
+    const int rows = source ? source->rowCount() : 0;
+    offsets.resize(rows + 1);
+    offsets[0] = 0;
+    for (int row = 0; row < rows; ++row) {
+        offsets[row + 1] = offsets[row] + quantityAt(row);
+    }
+}
+
+void CardCopyModel::shiftOffsets(int from_source_row, int delta)
+{
+    for (int i = from_source_row; i < offsets.size(); ++i) {
+        offsets[i] += delta;
+    }
+}
+
+void CardCopyModel::onRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    QList<int> quantities;
+    quantities.reserve(last - first + 1);
+    int copies = 0;
+    for (int row = first; row <= last; ++row) {
+        quantities.append(quantityAt(row));
+        copies += quantities.last();
+    }
+
+    const int position = offsets[first];
+    if (copies > 0) {
+        beginInsertRows(QModelIndex(), position, position + copies - 1);
+    }
+    // New source rows start where the displaced row started, everything behind them moves by the inserted copies
+    QList<int> inserted;
+    inserted.reserve(quantities.size());
+    int offset = position;
+    for (int quantity : std::as_const(quantities)) {
+        inserted.append(offset);
+        offset += quantity;
+    }
+    offsets.insert(first, inserted.size(), 0);
+    std::copy(inserted.cbegin(), inserted.cend(), offsets.begin() + first);
+    shiftOffsets(last + 1, copies);
+    if (copies > 0) {
+        endInsertRows();
+        emit countChanged();
+    }
+}
+
+void CardCopyModel::onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    pending_remove_first = first;
+    pending_remove_last = last;
+    if (offsets[last + 1] > offsets[first]) {
+        beginRemoveRows(QModelIndex(), offsets[first], offsets[last + 1] - 1);
+    }
+}
+
+void CardCopyModel::onRowsRemoved(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid() || first != pending_remove_first || last != pending_remove_last) {
+        return;
+    }
+
+    const int copies = offsets[last + 1] - offsets[first];
+    offsets.remove(first, last - first + 1);
+    shiftOffsets(first, -copies);
+    pending_remove_first = pending_remove_last = -1;
+    if (copies > 0) {
+        endRemoveRows();
+        emit countChanged();
+    }
+}
+
+void CardCopyModel::onDataChanged(const QModelIndex& top_left, const QModelIndex& bottom_right,
+                                  const QList<int>& roles)
+{
+    const bool quantity_changed = roles.isEmpty() || roles.contains(quantity_role);
+    for (int row = top_left.row(); row <= bottom_right.row(); ++row) {
+        const int old_quantity = offsets[row + 1] - offsets[row];
+        const int new_quantity = quantity_changed ? quantityAt(row) : old_quantity;
+
+        // Copies are added or dropped at the end of the card's block, the remaining copies keep their rows
+        if (new_quantity > old_quantity) {
+            const int position = offsets[row + 1];
+            beginInsertRows(QModelIndex(), position, position + new_quantity - old_quantity - 1);
+            shiftOffsets(row + 1, new_quantity - old_quantity);
+            endInsertRows();
+        } else if (new_quantity < old_quantity) {
+            const int position = offsets[row] + new_quantity;
+            beginRemoveRows(QModelIndex(), position, offsets[row + 1] - 1);
+            shiftOffsets(row + 1, new_quantity - old_quantity);
+            endRemoveRows();
+        }
+
+        if (new_quantity > 0) {
+            emit dataChanged(index(offsets[row]), index(offsets[row + 1] - 1), roles);
+        }
+    }
+    if (quantity_changed) {
+        emit countChanged();
+    }
+}
+
+void CardCopyModel::onReset()
+{
+    rebuildOffsets();
+    endResetModel();
+    emit countChanged();
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QPointer>
+#include <qqmlregistration.h>
+
+/*
+ * One row per physical copy of a grouped deck model (DeckModel or a DeckSectionModel).
+ *
+ * Copies are never materialized: a prefix sum over the source quantities maps a copy row to its source row with
+ * a binary search, so views only pay for the delegates they show. Source inserts, removals and quantity changes
+ * are translated into the matching copy row signals.
+ */
+class CardCopyModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(QAbstractItemModel* sourceModel READ getSourceModel WRITE setSourceModel NOTIFY sourceModelChanged)
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+
+public:
+    enum CopyRoles {
+        // Index of the copy within its card, 0 for the first copy
+        CopyIndexRole = Qt::UserRole + 100,
+        SourceRowRole,
+    };
+
+    explicit CardCopyModel(QObject* parent = nullptr);
+
+    QAbstractItemModel* getSourceModel() const { return source; }
+    void setSourceModel(QAbstractItemModel* model);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Source row holding the given copy row, or -1
+    Q_INVOKABLE int sourceRow(int copy_row) const;
+
+signals:
+    void sourceModelChanged();
+    void countChanged();
+
+private:
+    QPointer<QAbstractItemModel> source;
+    int quantity_role = -1;
+    // offsets[i] is the first copy row of source row i, offsets.last() the total number of copies
+    QList<int> offsets{0};
+    int pending_remove_first = -1;
+    int pending_remove_last = -1;
+
+    int quantityAt(int source_row) const;
+    void rebuildOffsets();
+    void shiftOffsets(int from_source_row, int delta);
+
+    void onRowsInserted(const QModelIndex& parent, int first, int last);
+    void onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+    void onRowsRemoved(const QModelIndex& parent, int first, int last);
+    void onDataChanged(const QModelIndex& top_left, const QModelIndex& bottom_right, const QList<int>& roles);
+    void onReset();
+};
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "card_search_model.h"
+#include "card_database/card_database.h"
+#include <QElapsedTimer>
+
+// CardSearchModel implementation
+CardSearchModel::CardSearchModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int CardSearchModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent)
+    return matches.size();
+}
+
+QVariant CardSearchModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= matches.size())
+        return QVariant();
+
+    const CardSearchIndex::Match& match = matches[index.row()];
+    const CardDatabase::CardView card = CardDatabase::instance().cardAt(match.record);
+
+    switch (role) {
+    case CardIdRole:
+        return card.id;
+    case NameRole:
+        return card.name.toString();
+    case TypeRole:
+        return Card::cardTypeToString(card.type);
+    case ImageSlugRole:
+        return card.slug.toString();
+    case IsCryptRole:
+        return (static_cast<int>(card.type) & static_cast<int>(Card::Type::Crypt)) != 0;
+    case ScoreRole:
+        return match.score;
+    }
+
+    return QVariant();
+}
+
+QHash<int, QByteArray> CardSearchModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[CardIdRole] = "cardId";
+    roles[NameRole] = "name";
+    roles[TypeRole] = "type";
+    roles[ImageSlugRole] = "imageSlug";
+    roles[IsCryptRole] = "isCrypt";
+    roles[ScoreRole] = "score";
+    return roles;
+}
+
+quint32 CardSearchModel::cardIdAt(int row) const
+{
+    if (row < 0 || row >= matches.size())
+        return 0;
+
+    return CardDatabase::instance().cardAt(matches[row].record).id;
+}
+
+void CardSearchModel::setQuery(const QString& new_query)
+{
+    if (query == new_query) {
+        return;
+    }
+    query = new_query;
+    emit queryChanged();
+    update();
+}
+
+void CardSearchModel::setLimit(int new_limit)
+{
+    if (limit == new_limit) {
+        return;
+    }
+    limit = new_limit;
+    emit limitChanged();
+    update();
+}
+
+void CardSearchModel::update()
+{
+    QElapsedTimer timer;
+    timer.start();
+    QList<CardSearchIndex::Match> results = CardSearchIndex::instance().search(query, limit);
+    search_time_us = timer.nsecsElapsed() / 1000;
+
+    beginResetModel();
+    matches = std::move(results);
+    endResetModel();
+    emit countChanged();
+}
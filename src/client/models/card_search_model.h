@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QList>
+#include <qqmlregistration.h>
+#include "card_database/card_search_index.h"
+
+// Top matches of the card database for a search box; the search reruns synchronously whenever query changes
+class CardSearchModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(QString query READ getQuery WRITE setQuery NOTIFY queryChanged)
+    Q_PROPERTY(int limit READ getLimit WRITE setLimit NOTIFY limitChanged)
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(qint64 searchTimeUs READ getSearchTimeUs NOTIFY countChanged)
+
+public:
+    enum SearchRoles {
+        CardIdRole = Qt::UserRole + 1,
+        NameRole,
+        TypeRole,
+        ImageSlugRole,
+        IsCryptRole,
+        ScoreRole,
+    };
+
+    static constexpr int DEFAULT_LIMIT = 20;
+
+    explicit CardSearchModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Card id of a result row, 0 when out of range; does not depend on the view having created the delegate
+    Q_INVOKABLE quint32 cardIdAt(int row) const;
+
+    QString getQuery() const { return query; }
+    void setQuery(const QString& new_query);
+    int getLimit() const { return limit; }
+    void setLimit(int new_limit);
+    qint64 getSearchTimeUs() const { return search_time_us; }
+
+signals:
+    void queryChanged();
+    void limitChanged();
+    void countChanged();
+
+private:
+    QString query;
+    int limit = DEFAULT_LIMIT;
+    QList<CardSearchIndex::Match> matches;
+    qint64 search_time_us = 0;
+
+    void update();
+};
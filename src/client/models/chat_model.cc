@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "chat_model.h"
+#include <QMetaObject>
+
+// ChatModel implementation
+ChatModel::ChatModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , lines(DEFAULT_CAPACITY)
+{
+}
+
+int ChatModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent)
+    return size;
+}
+
+QVariant ChatModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= size)
+        return QVariant();
+
+    const ChatLine& line = lineAt(index.row());
+
+    switch (role) {
+    case SenderRole:
+        return line.sender;
+    case TextRole:
+        return line.text;
+    case TimestampRole:
+        return QDateTime::fromMSecsSinceEpoch(line.timestamp);
+    case KindRole:
+        return line.kind;
+    }
+
+    return QVariant();
+}
+
+QHash<int, QByteArray> ChatModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[SenderRole] = "sender";
+    roles[TextRole] = "text";
+    roles[TimestampRole] = "timestamp";
+    roles[KindRole] = "kind";
+    return roles;
+}
+
+void ChatModel::setCapacity(int new_capacity)
+{
+    new_capacity = qMax(1, new_capacity);
+    if (new_capacity == lines.size()) {
+        return;
+    }
+
+    // Drop the oldest lines that no longer fit, then lay the rest out from the start of a new buffer
+    const int dropped = qMax(0, size - new_capacity);
+    if (dropped > 0) {
+        beginRemoveRows(QModelIndex(), 0, dropped - 1);
+    }
+    QList<ChatLine> resized(new_capacity);
+    for (int row = dropped; row < size; ++row) {
+        resized[row - dropped] = lineAt(row);
+    }
+    lines = std::move(resized);
+    head = 0;
+    size -= dropped;
+    if (dropped > 0) {
+        endRemoveRows();
+        emit countChanged();
+    }
+    emit capacityChanged();
+}
+
+void ChatModel::appendMessage(const QString& sender, const QString& text, Kind kind)
+{
+    pending.append({sender, text, QDateTime::currentMSecsSinceEpoch(), kind});
+    if (!flush_scheduled) {
+        flush_scheduled = true;
+        QMetaObject::invokeMethod(this, &ChatModel::flush, Qt::QueuedConnection);
+    }
+}
+
+void ChatModel::flush()
+{
+    flush_scheduled = false;
+    if (pending.isEmpty()) {
+        return;
+    }
+
+    const int capacity = lines.size();
+    // A burst larger than the buffer only keeps its newest lines
+    const int skipped = qMax(0, int(pending.size()) - capacity);
+    const int incoming = pending.size() - skipped;
+
+    const int evicted = qMax(0, size + incoming - capacity);
+    if (evicted > 0) {
+        // Evict the oldest lines in place; their slots are reused by the new ones
+        beginRemoveRows(QModelIndex(), 0, evicted - 1);
+        head = (head + evicted) % capacity;
+        size -= evicted;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), size, size + incoming - 1);
+    for (int i = skipped; i < pending.size(); ++i) {
+        lines[(head + size) % capacity] = std::move(pending[i]);
+        ++size;
+    }
+    endInsertRows();
+
+    ++insert_batches;
+    coalesced_messages += pending.size() - 1;
+    pending.clear();
+    emit countChanged();
+    emit statsChanged();
+}
+
+void ChatModel::clear()
+{
+    beginResetModel();
+    pending.clear();
+    head = 0;
+    size = 0;
+    lines.fill(ChatLine());
+    endResetModel();
+    emit countChanged();
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QDateTime>
+#include <QList>
+#include <QString>
+#include <qqmlregistration.h>
+
+/*
+ * Bounded chat history. Lines live in a ring buffer of fixed capacity: appending is a single row insert and,
+ * once full, the oldest lines are dropped with a single row removal, so long sessions cost the same per line as
+ * short ones.
+ *
+ * Appends are coalesced: lines arriving within the same event loop pass (e.g. a burst of server events) are
+ * queued and inserted together in one batch when control returns to the event loop.
+ */
+class ChatModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Chat models are provided by the controllers")
+
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(int capacity READ getCapacity WRITE setCapacity NOTIFY capacityChanged)
+    Q_PROPERTY(int insertBatches READ getInsertBatches NOTIFY statsChanged)
+    Q_PROPERTY(int coalescedMessages READ getCoalescedMessages NOTIFY statsChanged)
+
+public:
+    enum Kind {
+        Player,
+        System,
+    };
+    Q_ENUM(Kind)
+
+    enum ChatRoles {
+        SenderRole = Qt::UserRole + 1,
+        TextRole,
+        TimestampRole,
+        KindRole,
+    };
+
+    static constexpr int DEFAULT_CAPACITY = 500;
+
+    explicit ChatModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int getCapacity() const { return lines.size(); }
+    // Keeps the newest lines when shrinking
+    void setCapacity(int new_capacity);
+
+    // Queued until the next flush, see flush()
+    void appendMessage(const QString& sender, const QString& text, Kind kind = Player);
+    void appendSystemMessage(const QString& text) { appendMessage(QString(), text, System); }
+    Q_INVOKABLE void clear();
+
+    // Inserts all queued lines now; normally called from the event loop
+    void flush();
+
+    int getInsertBatches() const { return insert_batches; }
+    // Lines that did not need an insert of their own because they shared a batch
+    int getCoalescedMessages() const { return coalesced_messages; }
+
+signals:
+    void countChanged();
+    void capacityChanged();
+    void statsChanged();
+
+private:
+    struct ChatLine
+    {
+        QString sender;
+        QString text;
+        qint64 timestamp = 0; // ms since epoch
+        Kind kind = Player;
+    };
+
+    // Ring buffer; row r lives at lines[(head + r) % capacity]
+    QList<ChatLine> lines;
+    int head = 0;
+    int size = 0;
+
+    QList<ChatLine> pending;
+    bool flush_scheduled = false;
+    int insert_batches = 0;
+    int coalesced_messages = 0;
+
+    const ChatLine& lineAt(int row) const { return lines[(head + row) % lines.size()]; }
+};
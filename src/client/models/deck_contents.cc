@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "deck_contents.h"
+
+void DeckContents::add(const Card& card, int quantity)
+{
+    if (quantity <= 0) {
+        return;
+    }
+
+    const int row = find(card);
+    if (row >= 0) {
+        entries[row].quantity += quantity;
+    } else {
+        entries.append({QSharedPointer<const Card>::create(card), quantity});
+    }
+
+    if (card.isCrypt()) {
+        crypt_size += quantity;
+    } else {
+        library_size += quantity;
+    }
+}
+
+int DeckContents::find(const Card& card) const
+{
+    // Decks hold a few dozen distinct cards, a linear scan is cheaper than maintaining an index
+    for (int i = 0; i < entries.size(); ++i) {
+        const Card& entry_card = *entries[i].card;
+        if (card.getId() != 0 ? entry_card.getId() == card.getId() : entry_card.getName() == card.getName()) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void DeckContents::clear()
+{
+    name.clear();
+    author.clear();
+    description.clear();
+    entries.clear();
+    crypt_size = 0;
+    library_size = 0;
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+#include "models/card.h"
+
+// One distinct card in a deck together with the number of copies
+struct DeckEntry
+{
+    QSharedPointer<const Card> card;
+    int quantity = 0;
+};
+
+// Grouped deck contents, built off the GUI thread by DeckLoader and swapped into a DeckModel in one go
+struct DeckContents
+{
+    QString name;
+    QString author;
+    QString description;
+    QList<DeckEntry> entries;
+    int crypt_size = 0;
+    int library_size = 0;
+
+    // Adds copies of a card, merging them into an existing entry for the same card
+    void add(const Card& card, int quantity);
+    int find(const Card& card) const;
+    void clear();
+    bool isEmpty() const { return entries.isEmpty(); }
+};
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "deck_file_parser.h"
+#include <cstring>
+
+namespace {
+
+bool keyIs(QByteArrayView key, const char* name)
+{
+    const qsizetype length = qsizetype(strlen(name));
+    return key.size() == length && memcmp(key.data(), name, length) == 0;
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace
+
+// DeckFileParser implementation
+DeckFileParser::DeckFileParser(QByteArrayView json)
+    : pos(json.data())
+    , end(json.data() + json.size())
+{
+}
+
+bool DeckFileParser::parse(QByteArrayView json, Result& result)
+{
+    // Tolerate a UTF-8 byte order mark
+    if (json.startsWith("\xEF\xBB\xBF")) {
+        json = json.sliced(3);
+    }
+
+    DeckFileParser parser(json);
+    if (!parser.parseDeck(result)) {
+        return false;
+    }
+    parser.skipWhitespace();
+    return parser.pos == parser.end;
+}
+
+bool DeckFileParser::parseDeck(Result& result)
+{
+    if (!expect('{')) {
+        return false;
+    }
+    skipWhitespace();
+    if (pos < end && *pos == '}') {
+        ++pos;
+        return true;
+    }
+
+    while (true) {
+        QByteArrayView key;
+        bool key_escaped = false;
+        if (!parseString(key, key_escaped) || !expect(':')) {
+            return false;
+        }
+
+        skipWhitespace();
+        const bool is_string = pos < end && *pos == '"';
+        const bool is_array = pos < end && *pos == '[';
+
+        if (is_string && (keyIs(key, "name") || keyIs(key, "author") || keyIs(key, "description"))) {
+            QByteArrayView raw;
+            bool has_escapes = false;
+            if (!parseString(raw, has_escapes)) {
+                return false;
+            }
+            QString& target = keyIs(key, "name")     ? result.name
+                              : keyIs(key, "author") ? result.author
+                                                     : result.description;
+            target = decodeString(raw, has_escapes);
+        } else if (is_array && (keyIs(key, "crypt") || keyIs(key, "library"))) {
+            if (!parseCardArray(keyIs(key, "crypt"), result.entries)) {
+                return false;
+            }
+        } else if (!skipValue(1)) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (pos < end && *pos == ',') {
+            ++pos;
+            continue;
+        }
+        return expect('}');
+    }
+}
+
+bool DeckFileParser::parseCardArray(bool crypt, QList<Entry>& entries)
+{
+    if (!expect('[')) {
+        return false;
+    }
+    skipWhitespace();
+    if (pos < end && *pos == ']') {
+        ++pos;
+        return true;
+    }
+
+    while (true) {
+        skipWhitespace();
+        if (pos < end && *pos == '{') {
+            Entry entry;
+            entry.crypt = crypt;
+            if (!parseCardObject(entry)) {
+                return false;
+            }
+            entries.append(entry);
+        } else if (!skipValue(2)) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (pos < end && *pos == ',') {
+            ++pos;
+            continue;
+        }
+        return expect(']');
+    }
+}
+
+bool DeckFileParser::parseCardObject(Entry& entry)
+{
+    if (!expect('{')) {
+        return false;
+    }
+    skipWhitespace();
+    if (pos < end && *pos == '}') {
+        ++pos;
+        return true;
+    }
+
+    while (true) {
+        QByteArrayView key;
+        bool key_escaped = false;
+        if (!parseString(key, key_escaped) || !expect(':')) {
+            return false;
+        }
+
+        skipWhitespace();
+        const bool is_number = pos < end && (*pos == '-' || isDigit(*pos));
+        if (is_number && (keyIs(key, "count") || keyIs(key, "id"))) {
+            qint64 value = 0;
+            if (!parseInteger(value)) {
+                return false;
+            }
+            if (keyIs(key, "count")) {
+                entry.count = int(qBound<qint64>(0, value, 1 << 16));
+            } else {
+                entry.id = quint32(qBound<qint64>(0, value, 0xFFFFFFFF));
+            }
+        } else if (!skipValue(3)) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (pos < end && *pos == ',') {
+            ++pos;
+            continue;
+        }
+        return expect('}');
+    }
+}
+
+bool DeckFileParser::parseString(QByteArrayView& raw, bool& has_escapes)
+{
+    if (!expect('"')) {
+        return false;
+    }
+
+    const char* start = pos;
+    has_escapes = false;
+    while (pos < end) {
+        const char c = *pos;
+        if (c == '"') {
+            raw = QByteArrayView(start, pos - start);
+            ++pos;
+            return true;
+        }
+        if (c == '\\') {
+            has_escapes = true;
+            if (++pos >= end) {
+                return false;
+            }
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            return false;
+        }
+        ++pos;
+    }
+    return false;
+}
+
+bool DeckFileParser::parseInteger(qint64& value)
+{
+    const bool negative = pos < end && *pos == '-';
+    if (negative) {
+        ++pos;
+    }
+    if (pos >= end || !isDigit(*pos)) {
+        return false;
+    }
+
+    value = 0;
+    while (pos < end && isDigit(*pos)) {
+        if (value < (qint64(1) << 40)) {
+            value = value * 10 + (*pos - '0');
+        }
+        ++pos;
+    }
+
+    // Fractions and exponents are not meaningful for counts and ids, skip them
+    if (pos < end && *pos == '.') {
+        ++pos;
+        while (pos < end && isDigit(*pos))
+            ++pos;
+    }
+    if (pos < end && (*pos == 'e' || *pos == 'E')) {
+        ++pos;
+        if (pos < end && (*pos == '+' || *pos == '-'))
+            ++pos;
+        while (pos < end && isDigit(*pos))
+            ++pos;
+    }
+
+    if (negative) {
+        value = -value;
+    }
+    return true;
+}
+
+bool DeckFileParser::skipValue(int depth)
+{
+    if (depth > MAX_DEPTH) {
+        return false;
+    }
+
+    skipWhitespace();
+    if (pos >= end) {
+        return false;
+    }
+
+    switch (*pos) {
+    case '"': {
+        QByteArrayView raw;
+        bool has_escapes = false;
+        return parseString(raw, has_escapes);
+    }
+    case '{':
+    case '[': {
+        const char close = *pos == '{' ? '}' : ']';
+        const bool is_object = *pos == '{';
+        ++pos;
+        skipWhitespace();
+        if (pos < end && *pos == close) {
+            ++pos;
+            return true;
+        }
+        while (true) {
+            if (is_object) {
+                QByteArrayView key;
+                bool key_escaped = false;
+                if (!parseString(key, key_escaped) || !expect(':')) {
+                    return false;
+                }
+            }
+            if (!skipValue(depth + 1)) {
+                return false;
+            }
+            skipWhitespace();
+            if (pos < end && *pos == ',') {
+                ++pos;
+                skipWhitespace();
+                continue;
+            }
+            return expect(close);
+        }
+    }
+    case 't':
+    case 'f':
+    case 'n': {
+        for (const char* literal : {"true", "false", "null"}) {
+            const qsizetype length = qsizetype(strlen(literal));
+            if (end - pos >= length && memcmp(pos, literal, length) == 0) {
+                pos += length;
+                return true;
+            }
+        }
+        return false;
+    }
+    default: {
+        qint64 ignored = 0;
+        return parseInteger(ignored);
+    }
+    }
+}
+
+bool DeckFileParser::expect(char c)
+{
+    skipWhitespace();
+    if (pos < end && *pos == c) {
+        ++pos;
+        return true;
+    }
+    return false;
+}
+
+void DeckFileParser::skipWhitespace()
+{
+    while (pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t')) {
+        ++pos;
+    }
+}
+
+QString DeckFileParser::decodeString(QByteArrayView raw, bool has_escapes)
+{
+    if (!has_escapes) {
+        return QString::fromUtf8(raw);
+    }
+
+    QString decoded;
+    decoded.reserve(raw.size());
+    const char* p = raw.data();
+    const char* raw_end = raw.data() + raw.size();
+    const char* run = p;
+    while (p < raw_end) {
+        if (*p != '\\') {
+            ++p;
+            continue;
+        }
+
+        decoded += QString::fromUtf8(run, p - run);
+        const char escaped = p + 1 < raw_end ? p[1] : '\\';
+        p += 2;
+        switch (escaped) {
+        case 'b': decoded += QChar('\b'); break;
+        case 'f': decoded += QChar('\f'); break;
+        case 'n': decoded += QChar('\n'); break;
+        case 'r': decoded += QChar('\r'); break;
+        case 't': decoded += QChar('\t'); break;
+        case 'u': {
+            char16_t code = 0;
+            for (int i = 0; i < 4 && p < raw_end; ++i, ++p) {
+                const int digit = hexValue(*p);
+                code = char16_t((code << 4) | (digit < 0 ? 0 : digit));
+            }
+            // Surrogate pairs arrive as two escapes and combine naturally in UTF-16
+            decoded += QChar(code);
+            break;
+        }
+        default:
+            decoded += QLatin1Char(escaped);
+            break;
+        }
+        run = p;
+    }
+    decoded += QString::fromUtf8(run, raw_end - run);
+    return decoded;
+}
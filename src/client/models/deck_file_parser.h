@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QByteArrayView>
+#include <QList>
+#include <QString>
+
+/*
+ * Single pass parser for JSON deck files.
+ *
+ * Scans the raw UTF-8 bytes directly into (card id, count) entries, without building a QJsonDocument and without
+ * decoding the file to UTF-16 first. Only the deck name, author and description are materialized as QStrings;
+ * every other key is skipped.
+ */
+class DeckFileParser
+{
+public:
+    struct Entry
+    {
+        quint32 id = 0;
+        int count = 0;
+        bool crypt = false;
+    };
+
+    struct Result
+    {
+        QString name;
+        QString author;
+        QString description;
+        QList<Entry> entries;
+    };
+
+    static bool parse(QByteArrayView json, Result& result);
+
+private:
+    explicit DeckFileParser(QByteArrayView json);
+
+    static constexpr int MAX_DEPTH = 64;
+
+    const char* pos;
+    const char* end;
+
+    bool parseDeck(Result& result);
+    bool parseCardArray(bool crypt, QList<Entry>& entries);
+    bool parseCardObject(Entry& entry);
+    bool parseString(QByteArrayView& raw, bool& has_escapes);
+    bool parseInteger(qint64& value);
+    bool skipValue(int depth = 0);
+    bool expect(char c);
+    void skipWhitespace();
+
+    static QString decodeString(QByteArrayView raw, bool has_escapes);
+};
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "deck_loader.h"
+#include "card_database/card_database.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include "deck_file_parser.h"
+#include <QDir>
+#include <QtConcurrent>
+
+namespace {
+
+// Progress milestones of the load pipeline, in percent
+constexpr int PROGRESS_READ = 10;
+constexpr int PROGRESS_PARSED = 25;
+constexpr int PROGRESS_RESOLVED = 90;
+constexpr int PROGRESS_DONE = 100;
+
+} // namespace
+
+// DeckLoader implementation
+DeckLoader::DeckLoader(QObject* parent)
+    : QObject(parent)
+{
+    connect(&watcher, &QFutureWatcher<DeckContents>::progressValueChanged, this, &DeckLoader::progressChanged);
+    connect(&watcher, &QFutureWatcher<DeckContents>::finished, this, &DeckLoader::onFinished);
+    connect(&import_watcher, &QFutureWatcher<QList<DeckContents>>::finished, this, &DeckLoader::onImportFinished);
+}
+
+DeckLoader::~DeckLoader()
+{
+    // The workers only touch their own data, so it is enough to ask them to stop early
+    watcher.cancel();
+    import_watcher.cancel();
+}
+
+void DeckLoader::load(const QString& file_path)
+{
+    cancel();
+    current_file = file_path;
+    watcher.setFuture(QtConcurrent::run([file_path](QPromise<DeckContents>& promise) {
+        promise.setProgressRange(0, PROGRESS_DONE);
+        DeckContents contents;
+        if (loadContents(file_path, contents, &promise)) {
+            promise.addResult(std::move(contents));
+        }
+    }));
+}
+
+void DeckLoader::cancel()
+{
+    if (watcher.isRunning()) {
+        watcher.cancel();
+    }
+}
+
+void DeckLoader::importDirectory(const QString& directory)
+{
+    if (import_watcher.isRunning()) {
+        import_watcher.cancel();
+    }
+
+    QStringList files;
+    const QDir dir(directory);
+    for (const QString& name : dir.entryList({"*.json"}, QDir::Files | QDir::Readable, QDir::Name)) {
+        files << dir.filePath(name);
+    }
+
+    // Each file goes through the same pipeline as a single load, spread over all pool threads
+    import_timer.start();
+    import_watcher.setFuture(QtConcurrent::mappedReduced<QList<DeckContents>>(
+        files,
+        [](const QString& file_path) {
+            DeckContents contents;
+            if (!loadContents(file_path, contents)) {
+                contents.clear();
+            }
+            return contents;
+        },
+        [](QList<DeckContents>& decks, const DeckContents& contents) {
+            if (!contents.isEmpty()) {
+                decks.append(contents);
+            }
+        }));
+    import_file_count = files.size();
+}
+
+void DeckLoader::onImportFinished()
+{
+    if (import_watcher.isCanceled()) {
+        return;
+    }
+
+    const qint64 elapsed_ns = import_timer.nsecsElapsed();
+    const QList<DeckContents> decks = import_watcher.result();
+    const double decks_per_second = elapsed_ns > 0 ? import_file_count * 1e9 / elapsed_ns : 0.0;
+    emit directoryImported(decks, decks_per_second);
+}
+
+void DeckLoader::onFinished()
+{
+    if (watcher.isCanceled()) {
+        emit canceled();
+    } else if (watcher.future().resultCount() > 0) {
+        emit loaded(watcher.result());
+    } else {
+        emit failed(current_file);
+    }
+}
+
+bool DeckLoader::loadContents(const QString& file_path, DeckContents& contents, QPromise<DeckContents>* promise)
+{
+    auto report = [promise](int percent) {
+        if (promise) {
+            promise->setProgressValue(percent);
+        }
+    };
+    auto is_canceled = [promise]() { return promise && promise->isCanceled(); };
+
+    // Read: map the raw bytes once, falling back to a single read where mapping is unavailable
+    QFile file(file_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Cannot open file:" << file_path;
+        return false;
+    }
+
+    QByteArray buffer;
+    QByteArrayView bytes;
+    if (const uchar* mapped = file.size() > 0 ? file.map(0, file.size()) : nullptr) {
+        bytes = QByteArrayView(mapped, file.size());
+    } else {
+        buffer = file.readAll();
+        bytes = buffer;
+    }
+    report(PROGRESS_READ);
+    if (is_canceled()) {
+        return false;
+    }
+
+    // Parse straight from the UTF-8 bytes into (id, count) entries
+    DeckFileParser::Result parsed;
+    if (!DeckFileParser::parse(bytes, parsed)) {
+        return false;
+    }
+    contents.name = parsed.name;
+    contents.author = parsed.author;
+    contents.description = parsed.description;
+    report(PROGRESS_PARSED);
+
+    // Resolve card ids
+    const CardDatabase& database = CardDatabase::instance();
+
+    QList<QPair<Card, int>> resolved;
+    const qsizetype total = parsed.entries.size();
+    qsizetype processed = 0;
+    resolved.reserve(total);
+    for (const DeckFileParser::Entry& entry : std::as_const(parsed.entries)) {
+        if (is_canceled()) {
+            return false;
+        }
+
+        const CardDatabase::CardView view = database.lookup(entry.id);
+        if (!view.isValid() || entry.count <= 0) {
+            qDebug() << "Skipping unknown card id" << entry.id << "in" << file_path;
+        } else {
+            resolved.append({database.toCard(view), entry.count});
+        }
+        report(PROGRESS_PARSED + int((PROGRESS_RESOLVED - PROGRESS_PARSED) * ++processed / total));
+    }
+
+    // Build the grouped entries
+    for (const auto& [card, count] : resolved) {
+        contents.add(card, count);
+    }
+    report(PROGRESS_DONE);
+
+    if (promise) {
+        qDebug() << "Deck Name:" << contents.name;
+        qDebug() << "Author:" << contents.author;
+        qDebug() << "Description:" << contents.description;
+    }
+    return !contents.isEmpty(); // Return true if we loaded at least one card
+}
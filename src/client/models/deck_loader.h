@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QPromise>
+#include <QString>
+#include "models/deck_contents.h"
+
+/*
+ * Loads deck files on the thread pool: map the file, parse the raw bytes, resolve card ids and group the copies.
+ * Only the resulting DeckContents is handed back to the GUI thread, where DeckModel::setDeck swaps it in.
+ */
+class DeckLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DeckLoader(QObject* parent = nullptr);
+    ~DeckLoader() override;
+
+    // Starts a background load, canceling any load still in flight
+    void load(const QString& file_path);
+    void cancel();
+    bool isLoading() const { return watcher.isRunning(); }
+
+    // Loads every *.json deck of a directory in parallel; reports the throughput with directoryImported
+    void importDirectory(const QString& directory);
+
+    // The load pipeline itself; reports progress (0-100) and honors cancellation when a promise is given
+    static bool loadContents(const QString& file_path, DeckContents& contents,
+                             QPromise<DeckContents>* promise = nullptr);
+
+signals:
+    void progressChanged(int percent);
+    void loaded(const DeckContents& contents);
+    void failed(const QString& file_path);
+    void canceled();
+    void directoryImported(const QList<DeckContents>& decks, double decks_per_second);
+
+private:
+    QFutureWatcher<DeckContents> watcher;
+    QString current_file;
+    QFutureWatcher<QList<DeckContents>> import_watcher;
+    QElapsedTimer import_timer;
+    qsizetype import_file_count = 0;
+
+    void onFinished();
+    void onImportFinished();
+};
@@ -4,63 +4,51 @@
  */
 
 #include "deck_model.h"
+#include "deck_section_model.h"
+#include "deck_stats_model.h"
+#include "deck_loader.h"
+#include "card_database/card_database.h"
 #include <QDebug>
-#include <QFile>
-#include <QJsonArray>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QMap>
-#include <QRegularExpression>
-#include <QSet>
-#include <QTextStream>
+#include <algorithm>
 
 // DeckModel implementation
 DeckModel::DeckModel(QObject* parent)
     : QAbstractListModel(parent)
+    , crypt_model(new DeckSectionModel(this, DeckSectionModel::Section::Crypt, this))
+    , library_model(new DeckSectionModel(this, DeckSectionModel::Section::Library, this))
+    , stats_model(new DeckStatsModel(this))
 {
-    loadSampleDeck();
+    setDeck(sampleDeck());
 }
 
 int DeckModel::rowCount(const QModelIndex& parent) const
 {
     Q_UNUSED(parent)
-    return cards.size();
-}
-
-int DeckModel::getCryptSize() const {
-  int cnt = 0;
-  for (auto card : cards) {
-    if (card.getType() == Card::Type::Crypt) {
-      cnt++;
-    }
-  }
-  return cnt;
-}
-
-int DeckModel::getLibrarySize() const {
-  int cnt = 0;
-  for (auto card : cards) {
-    if (card.getType() != Card::Type::Crypt) {
-      cnt++;
-    }
-  }
-  return cnt;
+    return contents.entries.size();
 }
 
 QVariant DeckModel::data(const QModelIndex& index, int role) const
 {
-    if (!index.isValid() || index.row() >= cards.size())
+    if (!index.isValid() || index.row() >= contents.entries.size())
         return QVariant();
 
-    const Card& card = cards[index.row()];
+    const DeckEntry& entry = contents.entries[index.row()];
 
     switch (role) {
     case NameRole:
-        return card.getName();
+        return entry.card->getName();
     case TypeRole:
-        return card.typeString();
+        return entry.card->typeString();
     case ImageUrlRole:
-        return card.getImageUrl();
+        return entry.card->getImageUrl();
+    case QuantityRole:
+        return entry.quantity;
+    case CardIdRole:
+        return entry.card->getId();
+    case IsCryptRole:
+        return entry.card->isCrypt();
+    case ImageSlugRole:
+        return entry.card->getImageSlug();
     }
 
     return QVariant();
@@ -72,41 +60,46 @@ QHash<int, QByteArray> DeckModel::roleNames() const
     roles[NameRole] = "name";
     roles[TypeRole] = "type";
     roles[ImageUrlRole] = "imageUrl";
+    roles[QuantityRole] = "quantity";
+    roles[CardIdRole] = "cardId";
+    roles[IsCryptRole] = "isCrypt";
+    roles[ImageSlugRole] = "imageSlug";
     return roles;
 }
 
 void DeckModel::loadDeck(const QString& deck_file)
 {
-    beginResetModel();
-    cards.clear();
-    
+    DeckContents loaded;
     if (deck_file.isEmpty()) {
         // If no file is provided, load sample deck
-        loadSampleDeck();
-    } else {
-        // Try to parse the deck file
-        if (!parseDeckFile(deck_file)) {
-            // If parsing fails, load sample deck as fallback
-            qDebug() << "Failed to parse deck file, loading sample deck instead";
-            loadSampleDeck();
-        }
+        loaded = sampleDeck();
+    } else if (!DeckLoader::loadContents(deck_file, loaded)) {
+        // If parsing fails, load sample deck as fallback
+        qDebug() << "Failed to parse deck file, loading sample deck instead";
+        loaded = sampleDeck();
     }
-    
-    endResetModel();
+    setDeck(std::move(loaded));
 }
 
-void DeckModel::clearDeck()
+void DeckModel::setDeck(DeckContents new_contents)
 {
     beginResetModel();
-    cards.clear();
+    contents = std::move(new_contents);
     endResetModel();
+    stats_model->reset(contents);
+    emit sizesChanged();
+}
+
+void DeckModel::clearDeck()
+{
+    setDeck(DeckContents());
 }
 
 QStringList DeckModel::getCardTypes() const
 {
     QStringList types;
-    for (const Card& card : cards) {
-        QString typeStr = card.typeString();
+    for (const DeckEntry& entry : contents.entries) {
+        QString typeStr = entry.card->typeString();
         if (!types.contains(typeStr)) {
             types.append(typeStr);
         }
@@ -114,238 +107,139 @@ QStringList DeckModel::getCardTypes() const
     return types;
 }
 
-QVariantList DeckModel::getCryptCards() const
+void DeckModel::addCard(quint32 card_id, int count)
 {
-    QVariantList card_list;
-    QMap<QString, int> card_counts;
-    
-    // Count occurrences of each card
-    for (const Card& card : cards) {
-        if (card.getType() == Card::Type::Crypt) {
-            card_counts[card.getName()]++;
-        }
+    const CardDatabase& database = CardDatabase::instance();
+    const CardDatabase::CardView view = database.lookup(card_id);
+    if (!view.isValid() || count <= 0) {
+        return;
     }
-    
-    // Create unique cards with quantities
-    QSet<QString> processed_cards;
-    for (const Card& card : cards) {
-        if (card.getType() == Card::Type::Crypt && !processed_cards.contains(card.getName())) {
-            QVariantMap card_map;
-            card_map["name"] = card.getName();
-            card_map["type"] = card.typeString();
-            card_map["imageUrl"] = card.getImageUrl();
-            card_map["quantity"] = card_counts[card.getName()];
-            card_list.append(card_map);
-            processed_cards.insert(card.getName());
-        }
+
+    const Card card = database.toCard(view);
+    const int row = contents.find(card);
+    if (row >= 0) {
+        changeQuantity(row, count);
+        return;
     }
-    return card_list;
+
+    beginInsertRows(QModelIndex(), contents.entries.size(), contents.entries.size());
+    contents.add(card, count);
+    endInsertRows();
+    stats_model->applyChange(card, count);
+    emit sizesChanged();
 }
 
-QVariantList DeckModel::getLibraryCards() const
+void DeckModel::removeCard(quint32 card_id, int count)
 {
-    QVariantList card_list;
-    QMap<QString, int> card_counts;
-    
-    // Count occurrences of each card
-    for (const Card& card : cards) {
-        if (card.getType() != Card::Type::Crypt) {
-            card_counts[card.getName()]++;
-        }
+    auto it = std::find_if(contents.entries.cbegin(), contents.entries.cend(), [card_id](const DeckEntry& entry) {
+        return entry.card->getId() == card_id;
+    });
+    if (it != contents.entries.cend() && count > 0) {
+        changeQuantity(std::distance(contents.entries.cbegin(), it), -count);
     }
-    
-    // Create unique cards with quantities
-    QSet<QString> processed_cards;
-    for (const Card& card : cards) {
-        if (card.getType() != Card::Type::Crypt && !processed_cards.contains(card.getName())) {
-            QVariantMap card_map;
-            card_map["name"] = card.getName();
-            card_map["type"] = card.typeString();
-            card_map["imageUrl"] = card.getImageUrl();
-            card_map["quantity"] = card_counts[card.getName()];
-            card_list.append(card_map);
-            processed_cards.insert(card.getName());
-        }
+}
+
+void DeckModel::changeQuantity(int row, int delta)
+{
+    DeckEntry& entry = contents.entries[row];
+    delta = std::max(delta, -entry.quantity);
+    // Kept alive past the removal of the entry
+    const QSharedPointer<const Card> card = entry.card;
+    if (entry.card->isCrypt()) {
+        contents.crypt_size += delta;
+    } else {
+        contents.library_size += delta;
     }
-    return card_list;
+
+    if (entry.quantity + delta == 0) {
+        beginRemoveRows(QModelIndex(), row, row);
+        contents.entries.removeAt(row);
+        endRemoveRows();
+    } else {
+        entry.quantity += delta;
+        const QModelIndex idx = index(row);
+        emit dataChanged(idx, idx, {QuantityRole});
+    }
+    stats_model->applyChange(*card, delta);
+    emit sizesChanged();
+}
+
+QList<int> DeckModel::expandCopies() const
+{
+    QList<int> copies;
+    copies.reserve(contents.crypt_size + contents.library_size);
+    for (int i = 0; i < contents.entries.size(); ++i) {
+        copies.insert(copies.size(), contents.entries[i].quantity, i);
+    }
+    return copies;
 }
 
-void DeckModel::loadSampleDeck()
+DeckContents DeckModel::sampleDeck()
 {
-    // Sample VTEs cards - each Card needs: name, type, image_url, quantity
-    cards = {
+    // Sample VTEs cards - each entry needs: name, type, image_url and the number of copies
+    const Card::Type modifier_combat = static_cast<Card::Type>(
+        static_cast<int>(Card::Type::ActionModifier) | static_cast<int>(Card::Type::Combat));
+
+    const QList<QPair<Card, int>> sample_cards = {
         // Crypt
-        Card("Howler", Card::Type::Crypt, "https://static.krcg.org/card/howler.jpg"),
-        Card("Howler", Card::Type::Crypt, "https://static.krcg.org/card/howler.jpg"),
-        Card("Howler", Card::Type::Crypt, "https://static.krcg.org/card/howler.jpg"),
-        Card("Howler", Card::Type::Crypt, "https://static.krcg.org/card/howler.jpg"),
-
-        Card("Siamese", Card::Type::Crypt, "https://static.krcg.org/card/siamesethe.jpg"),
-        Card("Siamese", Card::Type::Crypt, "https://static.krcg.org/card/siamesethe.jpg"),
-        Card("Siamese", Card::Type::Crypt, "https://static.krcg.org/card/siamesethe.jpg"),
-
-        Card("Cynthia", Card::Type::Crypt, "https://static.krcg.org/card/cynthiaingold.jpg"),
-        Card("Cynthia", Card::Type::Crypt, "https://static.krcg.org/card/cynthiaingold.jpg"),
-        Card("Cynthia", Card::Type::Crypt, "https://static.krcg.org/card/cynthiaingold.jpg"),
-
-        Card("Nettie", Card::Type::Crypt, "https://static.krcg.org/card/nettiehale.jpg"),
-        Card("Juanita", Card::Type::Crypt, "https://static.krcg.org/card/juanitasantiago.jpg"),
-        
+        {Card("Howler", Card::Type::Crypt, "https://static.krcg.org/card/howler.jpg"), 4},
+        {Card("Siamese", Card::Type::Crypt, "https://static.krcg.org/card/siamesethe.jpg"), 3},
+        {Card("Cynthia", Card::Type::Crypt, "https://static.krcg.org/card/cynthiaingold.jpg"), 3},
+        {Card("Nettie", Card::Type::Crypt, "https://static.krcg.org/card/nettiehale.jpg"), 1},
+        {Card("Juanita", Card::Type::Crypt, "https://static.krcg.org/card/juanitasantiago.jpg"), 1},
+
         // Master
-        Card("Archon Investigation", Card::Type::Master, "https://static.krcg.org/card/archoninvestigation.jpg"),
-        Card("Guardian Angel", Card::Type::Master, "https://static.krcg.org/card/guardianangel.jpg"),
-        Card("Powerbase: Montreal", Card::Type::Master, "https://static.krcg.org/card/powerbasemontreal.jpg"),
-        Card("Rack, The", Card::Type::Master, "https://static.krcg.org/card/rackthe.jpg"),
-        Card("Smiling Jack, The Anarch", Card::Type::Master, "https://static.krcg.org/card/smilingjacktheanarch.jpg"),
-        Card("Vessel", Card::Type::Master, "https://static.krcg.org/card/vessel.jpg"),
-        Card("Vessel", Card::Type::Master, "https://static.krcg.org/card/vessel.jpg"),
-        Card("Vessel", Card::Type::Master, "https://static.krcg.org/card/vessel.jpg"),
-        Card("Vessel", Card::Type::Master, "https://static.krcg.org/card/vessel.jpg"),
-
-        Card("Villein", Card::Type::Master, "https://static.krcg.org/card/villein.jpg"),
-        Card("Villein", Card::Type::Master, "https://static.krcg.org/card/villein.jpg"),
-        Card("Villein", Card::Type::Master, "https://static.krcg.org/card/villein.jpg"),
-        Card("Villein", Card::Type::Master, "https://static.krcg.org/card/villein.jpg"),
-        
+        {Card("Archon Investigation", Card::Type::Master, "https://static.krcg.org/card/archoninvestigation.jpg"), 1},
+        {Card("Guardian Angel", Card::Type::Master, "https://static.krcg.org/card/guardianangel.jpg"), 1},
+        {Card("Powerbase: Montreal", Card::Type::Master, "https://static.krcg.org/card/powerbasemontreal.jpg"), 1},
+        {Card("Rack, The", Card::Type::Master, "https://static.krcg.org/card/rackthe.jpg"), 1},
+        {Card("Smiling Jack, The Anarch", Card::Type::Master, "https://static.krcg.org/card/smilingjacktheanarch.jpg"), 1},
+        {Card("Vessel", Card::Type::Master, "https://static.krcg.org/card/vessel.jpg"), 4},
+        {Card("Villein", Card::Type::Master, "https://static.krcg.org/card/villein.jpg"), 4},
+
         // Action
-        Card("Abbot", Card::Type::Action, "https://static.krcg.org/card/abbot.jpg"),
-        Card("Abbot", Card::Type::Action, "https://static.krcg.org/card/abbot.jpg"),
-        Card("Army of Rats", Card::Type::Action, "https://static.krcg.org/card/armyofrats.jpg"),
-        Card("Charge of the Buffalo", Card::Type::Action, "https://static.krcg.org/card/chargeofthebuffalo.jpg"),
-        Card("Charge of the Buffalo", Card::Type::Action, "https://static.krcg.org/card/chargeofthebuffalo.jpg"),
-        Card("Enchant Kindred", Card::Type::Action, "https://static.krcg.org/card/enchantkindred.jpg"),
-        Card("Enchant Kindred", Card::Type::Action, "https://static.krcg.org/card/enchantkindred.jpg"),
-        Card("Enchant Kindred", Card::Type::Action, "https://static.krcg.org/card/enchantkindred.jpg"),
-        Card("Enchant Kindred", Card::Type::Action, "https://static.krcg.org/card/enchantkindred.jpg"),
-        Card("Enchant Kindred", Card::Type::Action, "https://static.krcg.org/card/enchantkindred.jpg"),
-        Card("Enchant Kindred", Card::Type::Action, "https://static.krcg.org/card/enchantkindred.jpg"),
-        Card("Enchant Kindred", Card::Type::Action, "https://static.krcg.org/card/enchantkindred.jpg"),
-
-        Card("Engling Fury", Card::Type::Action, "https://static.krcg.org/card/englingfury.jpg"),
-        Card("Engling Fury", Card::Type::Action, "https://static.krcg.org/card/englingfury.jpg"),
-        Card("Engling Fury", Card::Type::Action, "https://static.krcg.org/card/englingfury.jpg"),
-        Card("Engling Fury", Card::Type::Action, "https://static.krcg.org/card/englingfury.jpg"),
-        
+        {Card("Abbot", Card::Type::Action, "https://static.krcg.org/card/abbot.jpg"), 2},
+        {Card("Army of Rats", Card::Type::Action, "https://static.krcg.org/card/armyofrats.jpg"), 1},
+        {Card("Charge of the Buffalo", Card::Type::Action, "https://static.krcg.org/card/chargeofthebuffalo.jpg"), 2},
+        {Card("Enchant Kindred", Card::Type::Action, "https://static.krcg.org/card/enchantkindred.jpg"), 7},
+        {Card("Engling Fury", Card::Type::Action, "https://static.krcg.org/card/englingfury.jpg"), 4},
+
         // Ally
-        Card("High Top", Card::Type::Ally, "https://static.krcg.org/card/hightop.jpg"),
-        Card("Ossian", Card::Type::Ally, "https://static.krcg.org/card/ossian.jpg"),
-        
+        {Card("High Top", Card::Type::Ally, "https://static.krcg.org/card/hightop.jpg"), 1},
+        {Card("Ossian", Card::Type::Ally, "https://static.krcg.org/card/ossian.jpg"), 1},
+
         // Action Modifier
-        Card("Aire of Elation", Card::Type::ActionModifier, "https://static.krcg.org/card/aireofelation.jpg"),
-        Card("Aire of Elation", Card::Type::ActionModifier, "https://static.krcg.org/card/aireofelation.jpg"),
+        {Card("Aire of Elation", Card::Type::ActionModifier, "https://static.krcg.org/card/aireofelation.jpg"), 2},
+        {Card("Squirrel Balance", Card::Type::ActionModifier, "https://static.krcg.org/card/squirrelbalance.jpg"), 3},
 
-        Card("Squirrel Balance", Card::Type::ActionModifier, "https://static.krcg.org/card/squirrelbalance.jpg"),
-        Card("Squirrel Balance", Card::Type::ActionModifier, "https://static.krcg.org/card/squirrelbalance.jpg"),
-        Card("Squirrel Balance", Card::Type::ActionModifier, "https://static.krcg.org/card/squirrelbalance.jpg"),
-        
         // Action Modifier/Combat
-        Card("Swiftness of the Stag", static_cast<Card::Type>( static_cast<int>(Card::Type::ActionModifier) | static_cast<int>(Card::Type::Combat)), "https://static.krcg.org/card/swiftnessofthestag.jpg"),
-        Card("Swiftness of the Stag", static_cast<Card::Type>( static_cast<int>(Card::Type::ActionModifier) | static_cast<int>(Card::Type::Combat)), "https://static.krcg.org/card/swiftnessofthestag.jpg"),
-        Card("Swiftness of the Stag", static_cast<Card::Type>( static_cast<int>(Card::Type::ActionModifier) | static_cast<int>(Card::Type::Combat)), "https://static.krcg.org/card/swiftnessofthestag.jpg"),
-        Card("Swiftness of the Stag", static_cast<Card::Type>( static_cast<int>(Card::Type::ActionModifier) | static_cast<int>(Card::Type::Combat)), "https://static.krcg.org/card/swiftnessofthestag.jpg"),
-        Card("Swiftness of the Stag", static_cast<Card::Type>( static_cast<int>(Card::Type::ActionModifier) | static_cast<int>(Card::Type::Combat)), "https://static.krcg.org/card/swiftnessofthestag.jpg"),
-        Card("Swiftness of the Stag", static_cast<Card::Type>( static_cast<int>(Card::Type::ActionModifier) | static_cast<int>(Card::Type::Combat)), "https://static.krcg.org/card/swiftnessofthestag.jpg"),
-        Card("Swiftness of the Stag", static_cast<Card::Type>( static_cast<int>(Card::Type::ActionModifier) | static_cast<int>(Card::Type::Combat)), "https://static.krcg.org/card/swiftnessofthestag.jpg"),
-        Card("Swiftness of the Stag", static_cast<Card::Type>( static_cast<int>(Card::Type::ActionModifier) | static_cast<int>(Card::Type::Combat)), "https://static.krcg.org/card/swiftnessofthestag.jpg"),
-        
+        {Card("Swiftness of the Stag", modifier_combat, "https://static.krcg.org/card/swiftnessofthestag.jpg"), 8},
+
         // Reaction
-        Card("Cats\x27 Guidance", Card::Type::Reaction, "https://static.krcg.org/card/catsguidance.jpg"),
-        Card("Cats\x27 Guidance", Card::Type::Reaction, "https://static.krcg.org/card/catsguidance.jpg"),
-        Card("Cats\x27 Guidance", Card::Type::Reaction, "https://static.krcg.org/card/catsguidance.jpg"),
-        Card("Cats\x27 Guidance", Card::Type::Reaction, "https://static.krcg.org/card/catsguidance.jpg"),
-
-        Card("Ears of the Hare", Card::Type::Reaction, "https://static.krcg.org/card/earsofthehare.jpg"),
-        Card("Ears of the Hare", Card::Type::Reaction, "https://static.krcg.org/card/earsofthehare.jpg"),
-        Card("Ears of the Hare", Card::Type::Reaction, "https://static.krcg.org/card/earsofthehare.jpg"),
-        Card("Ears of the Hare", Card::Type::Reaction, "https://static.krcg.org/card/earsofthehare.jpg"),
-        Card("Ears of the Hare", Card::Type::Reaction, "https://static.krcg.org/card/earsofthehare.jpg"),
-        Card("Ears of the Hare", Card::Type::Reaction, "https://static.krcg.org/card/earsofthehare.jpg"),
-
-        Card("Falcon\x27s Eye", Card::Type::Reaction, "https://static.krcg.org/card/falconseye.jpg"),
-        Card("On the Qui Vive", Card::Type::Reaction, "https://static.krcg.org/card/onthequivive.jpg"),
-        Card("On the Qui Vive", Card::Type::Reaction, "https://static.krcg.org/card/onthequivive.jpg"),
-        Card("On the Qui Vive", Card::Type::Reaction, "https://static.krcg.org/card/onthequivive.jpg"),
-        Card("Speak with Spirits", Card::Type::Reaction, "https://static.krcg.org/card/speakwithspirits.jpg"),
-        Card("Speak with Spirits", Card::Type::Reaction, "https://static.krcg.org/card/speakwithspirits.jpg"),
-        Card("Speak with Spirits", Card::Type::Reaction, "https://static.krcg.org/card/speakwithspirits.jpg"),
-        Card("Speak with Spirits", Card::Type::Reaction, "https://static.krcg.org/card/speakwithspirits.jpg"),
-        Card("Speak with Spirits", Card::Type::Reaction, "https://static.krcg.org/card/speakwithspirits.jpg"),
-        Card("Speak with Spirits", Card::Type::Reaction, "https://static.krcg.org/card/speakwithspirits.jpg"),
-        Card("Speak with Spirits", Card::Type::Reaction, "https://static.krcg.org/card/speakwithspirits.jpg"),
-        Card("Speak with Spirits", Card::Type::Reaction, "https://static.krcg.org/card/speakwithspirits.jpg"),
-        
+        {Card("Cats\x27 Guidance", Card::Type::Reaction, "https://static.krcg.org/card/catsguidance.jpg"), 4},
+        {Card("Ears of the Hare", Card::Type::Reaction, "https://static.krcg.org/card/earsofthehare.jpg"), 6},
+        {Card("Falcon\x27s Eye", Card::Type::Reaction, "https://static.krcg.org/card/falconseye.jpg"), 1},
+        {Card("On the Qui Vive", Card::Type::Reaction, "https://static.krcg.org/card/onthequivive.jpg"), 3},
+        {Card("Speak with Spirits", Card::Type::Reaction, "https://static.krcg.org/card/speakwithspirits.jpg"), 8},
+
         // Combat
-        Card("Canine Horde", Card::Type::Combat, "https://static.krcg.org/card/caninehorde.jpg"),
-        Card("Carrion Crows", Card::Type::Combat, "https://static.krcg.org/card/carrioncrows.jpg"),
-        Card("Carrion Crows", Card::Type::Combat, "https://static.krcg.org/card/carrioncrows.jpg"),
-        Card("Carrion Crows", Card::Type::Combat, "https://static.krcg.org/card/carrioncrows.jpg"),
-        Card("Drawing Out the Beast", Card::Type::Combat, "https://static.krcg.org/card/drawingoutthebeast.jpg"),
-        Card("Drawing Out the Beast", Card::Type::Combat, "https://static.krcg.org/card/drawingoutthebeast.jpg"),
-        Card("Target Vitals", Card::Type::Combat, "https://static.krcg.org/card/targetvitals.jpg"),
-        Card("Target Vitals", Card::Type::Combat, "https://static.krcg.org/card/targetvitals.jpg"),
-        Card("Target Vitals", Card::Type::Combat, "https://static.krcg.org/card/targetvitals.jpg"),
-        Card("Target Vitals", Card::Type::Combat, "https://static.krcg.org/card/targetvitals.jpg"),
-        Card("Target Vitals", Card::Type::Combat, "https://static.krcg.org/card/targetvitals.jpg"),
-        Card("Target Vitals", Card::Type::Combat, "https://static.krcg.org/card/targetvitals.jpg"),
-        Card("Taste of Vitae", Card::Type::Combat, "https://static.krcg.org/card/tasteofvitae.jpg"),
-        Card("Taste of Vitae", Card::Type::Combat, "https://static.krcg.org/card/tasteofvitae.jpg"),
-        Card("Taste of Vitae", Card::Type::Combat, "https://static.krcg.org/card/tasteofvitae.jpg"),
-        Card("Taste of Vitae", Card::Type::Combat, "https://static.krcg.org/card/tasteofvitae.jpg"),
-        Card("Weighted Walking Stick", Card::Type::Combat, "https://static.krcg.org/card/weightedwalkingstick.jpg"),
-        Card("Weighted Walking Stick", Card::Type::Combat, "https://static.krcg.org/card/weightedwalkingstick.jpg"),
-        Card("Weighted Walking Stick", Card::Type::Combat, "https://static.krcg.org/card/weightedwalkingstick.jpg"),
-        Card("Weighted Walking Stick", Card::Type::Combat, "https://static.krcg.org/card/weightedwalkingstick.jpg"),
-        Card("Weighted Walking Stick", Card::Type::Combat, "https://static.krcg.org/card/weightedwalkingstick.jpg"),
-        Card("Weighted Walking Stick", Card::Type::Combat, "https://static.krcg.org/card/weightedwalkingstick.jpg"),
-        
+        {Card("Canine Horde", Card::Type::Combat, "https://static.krcg.org/card/caninehorde.jpg"), 1},
+        {Card("Carrion Crows", Card::Type::Combat, "https://static.krcg.org/card/carrioncrows.jpg"), 3},
+        {Card("Drawing Out the Beast", Card::Type::Combat, "https://static.krcg.org/card/drawingoutthebeast.jpg"), 2},
+        {Card("Target Vitals", Card::Type::Combat, "https://static.krcg.org/card/targetvitals.jpg"), 6},
+        {Card("Taste of Vitae", Card::Type::Combat, "https://static.krcg.org/card/tasteofvitae.jpg"), 4},
+        {Card("Weighted Walking Stick", Card::Type::Combat, "https://static.krcg.org/card/weightedwalkingstick.jpg"), 6},
+
         // Event
-        Card("Narrow Minds", Card::Type::Event, "https://static.krcg.org/card/narrowminds.jpg"),
+        {Card("Narrow Minds", Card::Type::Event, "https://static.krcg.org/card/narrowminds.jpg"), 1},
     };
-}
 
-bool DeckModel::parseDeckFile(const QString& filePath)
-{
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "Cannot open file:" << filePath;
-        return false;
-    }
-    
-    QJsonDocument doc;
-    QTextStream in(&file);
-    while (!in.atEnd()) {
-        doc = QJsonDocument::fromJson(in.readAll().toUtf8());
-    }
-    if (doc.isNull() || !doc.isObject() || doc.isEmpty()) { return false; }
-
-    QJsonObject obj = doc.object();
-
-    // Extract top-level string values.
-    QString name = obj.value("name").toString();
-    QString author = obj.value("author").toString();
-    QString description = obj.value("description").toString();
-
-    qDebug() << "Deck Name:" << name;
-    qDebug() << "Author:" << author;
-    qDebug() << "Description:" << description;
-
-    // Extract the "crypt" array.
-
-    QStringList section_lists;
-    section_lists << "crypt" << "library";
-    Q_FOREACH(const QString &section, section_lists) {
-        QJsonArray card_array = obj.value(section).toArray();
-        for (const QJsonValue &value : card_array) {
-            if (value.isObject()) {
-                QJsonObject card_object = value.toObject();
-                int count = card_object.value("count").toInt();
-                int id = card_object.value("id").toInt();
-                // Todo; lookup card id
-                // Add for 'count'-times card to `cards`
-            }
-        }
+    DeckContents sample;
+    sample.name = "Sample Deck";
+    for (const auto& [card, quantity] : sample_cards) {
+        sample.add(card, quantity);
     }
-    return !cards.isEmpty(); // Return true if we loaded at least one card
+    return sample;
 }
 
 Card::Type DeckModel::parseCardType(const QString& typeString)
@@ -9,39 +9,79 @@
 #include <QVariantMap>
 #include <qqmlregistration.h>
 #include "models/card.h"
+#include "models/deck_contents.h"
+
+class DeckSectionModel;
+class DeckStatsModel;
+// moc needs the complete types of the properties below
+Q_MOC_INCLUDE("models/deck_section_model.h")
+Q_MOC_INCLUDE("models/deck_stats_model.h")
 
 class DeckModel : public QAbstractListModel
 {
     Q_OBJECT
     QML_ELEMENT
 
+    Q_PROPERTY(int cryptSize READ getCryptSize NOTIFY sizesChanged)
+    Q_PROPERTY(int librarySize READ getLibrarySize NOTIFY sizesChanged)
+    Q_PROPERTY(DeckSectionModel* cryptModel READ getCryptModel CONSTANT)
+    Q_PROPERTY(DeckSectionModel* libraryModel READ getLibraryModel CONSTANT)
+    Q_PROPERTY(DeckStatsModel* statsModel READ getStatsModel CONSTANT)
+
 public:
     enum DeckRoles {
         NameRole = Qt::UserRole + 1,
         TypeRole,
         ImageUrlRole,
+        QuantityRole,
+        CardIdRole,
+        IsCryptRole,
+        ImageSlugRole,
     };
 
     explicit DeckModel(QObject* parent = nullptr);
 
+    // One row per distinct card, see QuantityRole for the number of copies
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
-    Q_INVOKABLE int getCryptSize() const;
-    Q_INVOKABLE int getLibrarySize() const;
+    Q_INVOKABLE int getCryptSize() const { return contents.crypt_size; }
+    Q_INVOKABLE int getLibrarySize() const { return contents.library_size; }
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+    // Synchronous load, see DeckLoader for loading off the GUI thread
     Q_INVOKABLE void loadDeck(const QString& deck_file);
+    // Replaces the whole deck in a single model reset
+    void setDeck(DeckContents new_contents);
     Q_INVOKABLE void clearDeck();
     Q_INVOKABLE QStringList getCardTypes() const;
 
-    Q_INVOKABLE QVariantList getCryptCards() const;
-    Q_INVOKABLE QVariantList getLibraryCards() const;
+    // Deck edits, reported as row inserts/removals and quantity changes rather than resets
+    Q_INVOKABLE void addCard(quint32 card_id, int count = 1);
+    Q_INVOKABLE void removeCard(quint32 card_id, int count = 1);
+
+    DeckSectionModel* getCryptModel() const { return crypt_model; }
+    DeckSectionModel* getLibraryModel() const { return library_model; }
+    DeckStatsModel* getStatsModel() const { return stats_model; }
+
+    const QList<DeckEntry>& getEntries() const { return contents.entries; }
+    const DeckContents& getContents() const { return contents; }
+
+    static DeckContents sampleDeck();
+
+    // Expands the deck into one element per physical copy, holding the index of the copy's entry
+    QList<int> expandCopies() const;
+
+signals:
+    void sizesChanged();
 
 private:
-    QList<Card> cards;
-    void loadSampleDeck();
-    bool parseDeckFile(const QString& filePath);
+    DeckContents contents;
+    DeckSectionModel* crypt_model;
+    DeckSectionModel* library_model;
+    DeckStatsModel* stats_model;
+
+    void changeQuantity(int row, int delta);
     bool parseDeckLine(const QString& line);
     Card::Type parseCardType(const QString& typeString);
     QString generateImageUrl(const QString& cardName);
-};
\ No newline at end of file
+};
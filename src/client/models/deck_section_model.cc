@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "deck_section_model.h"
+#include "deck_model.h"
+
+// DeckSectionModel implementation
+DeckSectionModel::DeckSectionModel(DeckModel* deck_model, Section section, QObject* parent)
+    : QSortFilterProxyModel(parent)
+    , deck_model(deck_model)
+    , section(section)
+{
+    // Only the crypt flag decides membership, so re-filtering on quantity changes is not needed
+    setFilterRole(DeckModel::IsCryptRole);
+    setDynamicSortFilter(false);
+    setSourceModel(deck_model);
+
+    connect(deck_model, &DeckModel::sizesChanged, this, &DeckSectionModel::totalCardsChanged);
+}
+
+int DeckSectionModel::getTotalCards() const
+{
+    return section == Section::Crypt ? deck_model->getCryptSize() : deck_model->getLibrarySize();
+}
+
+bool DeckSectionModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
+{
+    const QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
+    return index.data(DeckModel::IsCryptRole).toBool() == (section == Section::Crypt);
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QSortFilterProxyModel>
+#include <qqmlregistration.h>
+
+class DeckModel;
+
+// Crypt or library view on a DeckModel. Rows are the deck's grouped entries, so source inserts, removals and
+// quantity changes are forwarded as fine-grained row signals instead of rebuilding the section.
+class DeckSectionModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Sections are provided by DeckModel")
+
+    Q_PROPERTY(int totalCards READ getTotalCards NOTIFY totalCardsChanged)
+
+public:
+    enum class Section {
+        Crypt,
+        Library,
+    };
+
+    DeckSectionModel(DeckModel* deck_model, Section section, QObject* parent = nullptr);
+
+    Section getSection() const { return section; }
+    int getTotalCards() const;
+
+signals:
+    void totalCardsChanged();
+
+protected:
+    bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
+
+private:
+    DeckModel* deck_model;
+    Section section;
+};
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "deck_stats_model.h"
+#include "game/deck_engine.h"
+#include "game/hypergeometric.h"
+#include <QElapsedTimer>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <tuple>
+
+// DeckStatsModel implementation
+DeckStatsModel::DeckStatsModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int DeckStatsModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent)
+    return rows.size();
+}
+
+QVariant DeckStatsModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size())
+        return QVariant();
+
+    const Row& row = rows[index.row()];
+
+    switch (role) {
+    case SectionRole:
+        return sectionName(row.section);
+    case LabelRole:
+        return row.label;
+    case CountRole:
+        return row.count;
+    case SuperiorRole:
+        return row.superior;
+    case ProbabilityRole:
+        return row.probability;
+    case ExpectedRole:
+        return row.expected;
+    }
+
+    return QVariant();
+}
+
+QHash<int, QByteArray> DeckStatsModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[SectionRole] = "section";
+    roles[LabelRole] = "label";
+    roles[CountRole] = "count";
+    roles[SuperiorRole] = "superior";
+    roles[ProbabilityRole] = "probability";
+    roles[ExpectedRole] = "expected";
+    return roles;
+}
+
+void DeckStatsModel::reset(const DeckContents& contents)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    beginResetModel();
+    rows.clear();
+    library_size = 0;
+    crypt_size = 0;
+    capacity_total = 0;
+    capacity_cards = 0;
+    for (const DeckEntry& entry : contents.entries) {
+        countCard(*entry.card, entry.quantity, false);
+    }
+    refresh(true, true, false);
+    endResetModel();
+
+    last_update_us = timer.nsecsElapsed() / 1000.0;
+    emit statsChanged();
+}
+
+void DeckStatsModel::applyChange(const Card& card, int delta)
+{
+    if (delta == 0) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    countCard(card, delta, true);
+    refresh(!card.isCrypt(), card.isCrypt(), true);
+
+    last_update_us = timer.nsecsElapsed() / 1000.0;
+    emit statsChanged();
+}
+
+void DeckStatsModel::countCard(const Card& card, int delta, bool notify)
+{
+    Row key;
+    key.section = Section::Card;
+    key.key = card.isCrypt() ? 0 : 1;
+    key.name = card.getName();
+    key.card_id = card.getId();
+    adjustRow(key, delta, 0, notify);
+
+    if (!card.isCrypt()) {
+        library_size += delta;
+        for (int bits = static_cast<int>(card.getType()); bits != 0; bits &= bits - 1) {
+            const int bit = qCountTrailingZeroBits(quint32(bits));
+            adjustRow({Section::Type, bit}, delta, 0, notify);
+        }
+        return;
+    }
+
+    crypt_size += delta;
+    if (card.getCapacity() > 0) {
+        capacity_total += qint64(card.getCapacity()) * delta;
+        capacity_cards += delta;
+        adjustRow({Section::Capacity, card.getCapacity()}, delta, 0, notify);
+    }
+    const quint64 superior = card.getSuperiorDisciplines();
+    for (quint64 bits = card.getDisciplines(); bits != 0; bits &= bits - 1) {
+        const int discipline = qCountTrailingZeroBits(bits);
+        const int superior_delta = (superior >> discipline) & 1 ? delta : 0;
+        adjustRow({Section::Discipline, discipline}, delta, superior_delta, notify);
+    }
+}
+
+void DeckStatsModel::adjustRow(const Row& key, int delta, int superior_delta, bool notify)
+{
+    const auto it = std::lower_bound(rows.begin(), rows.end(), key, &DeckStatsModel::lessThan);
+    const int position = int(std::distance(rows.begin(), it));
+
+    if (it == rows.end() || lessThan(key, *it)) {
+        if (delta <= 0) {
+            return;
+        }
+        Row row = key;
+        row.label = labelFor(key);
+        row.count = delta;
+        row.superior = superior_delta;
+        row.dirty = true;
+        if (notify) {
+            beginInsertRows(QModelIndex(), position, position);
+        }
+        rows.insert(position, std::move(row));
+        if (notify) {
+            endInsertRows();
+        }
+        return;
+    }
+
+    it->count += delta;
+    it->superior += superior_delta;
+    if (it->count > 0) {
+        it->dirty = true;
+        return;
+    }
+    if (notify) {
+        beginRemoveRows(QModelIndex(), position, position);
+    }
+    rows.removeAt(position);
+    if (notify) {
+        endRemoveRows();
+    }
+}
+
+void DeckStatsModel::refresh(bool library_changed, bool crypt_changed, bool notify)
+{
+    const int library_draws = std::min(DeckEngine::OPENING_HAND, library_size);
+    const int crypt_draws = std::min(DeckEngine::OPENING_CRYPT, crypt_size);
+
+    int first = -1;
+    int last = -1;
+    for (int i = 0; i < rows.size(); ++i) {
+        Row& row = rows[i];
+        const bool crypt = row.isCrypt();
+        if (!row.dirty && !(crypt ? crypt_changed : library_changed)) {
+            continue;
+        }
+        const int population = crypt ? crypt_size : library_size;
+        const int draws = crypt ? crypt_draws : library_draws;
+        row.probability = Hypergeometric::atLeast(population, row.count, draws, 1);
+        row.expected = Hypergeometric::expected(population, row.count, draws);
+        row.dirty = false;
+        if (first < 0) {
+            first = i;
+        }
+        last = i;
+    }
+
+    if (notify && first >= 0) {
+        emit dataChanged(index(first), index(last), {CountRole, SuperiorRole, ProbabilityRole, ExpectedRole});
+    }
+}
+
+bool DeckStatsModel::Row::isCrypt() const
+{
+    switch (section) {
+    case Section::Type:
+        return false;
+    case Section::Card:
+        return key == 0;
+    case Section::Capacity:
+    case Section::Discipline:
+        return true;
+    }
+    return false;
+}
+
+bool DeckStatsModel::lessThan(const Row& a, const Row& b)
+{
+    return std::tie(a.section, a.key, a.name, a.card_id) < std::tie(b.section, b.key, b.name, b.card_id);
+}
+
+QString DeckStatsModel::labelFor(const Row& row)
+{
+    switch (row.section) {
+    case Section::Type:
+        return Card::cardTypeToString(static_cast<Card::Type>(1 << row.key));
+    case Section::Card:
+        return row.name;
+    case Section::Capacity:
+        return QString("Capacity %1").arg(row.key);
+    case Section::Discipline:
+        return Card::disciplineName(row.key);
+    }
+    return QString();
+}
+
+QString DeckStatsModel::sectionName(Section section)
+{
+    switch (section) {
+    case Section::Type:
+        return "Types";
+    case Section::Card:
+        return "Cards";
+    case Section::Capacity:
+        return "Capacity";
+    case Section::Discipline:
+        return "Disciplines";
+    }
+    return QString();
+}
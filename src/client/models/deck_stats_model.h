@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QList>
+#include <qqmlregistration.h>
+#include "models/card.h"
+#include "models/deck_contents.h"
+
+/*
+ * Exact opening draw statistics of a deck, for the stats panel of the deck builder. Rows, grouped by section:
+ *
+ *   Types        per library card type, copies and the chance of at least one in the opening hand
+ *   Capacity     per capacity, vampires and the chance of at least one in the opening crypt
+ *   Disciplines  per discipline, vampires having it (and at superior) and the same chance
+ *   Cards        per card, copies and the chance of drawing it into the opening hand or crypt
+ *
+ * The counts are kept edit by edit: a quantity change only touches the rows of the card, its type bits,
+ * capacity and disciplines, inserting or removing them as counts appear or drop to zero. The pile size changes
+ * too, so the probabilities of that pile are recomputed; each is a closed-form hypergeometric term of O(draws),
+ * which keeps an edit in the microseconds however many rows are shown. Only a new deck rebuilds the rows.
+ */
+class DeckStatsModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Deck statistics are provided by DeckModel")
+
+    Q_PROPERTY(double averageCapacity READ getAverageCapacity NOTIFY statsChanged)
+    Q_PROPERTY(double lastUpdateUs READ getLastUpdateUs NOTIFY statsChanged)
+
+public:
+    enum StatsRoles {
+        SectionRole = Qt::UserRole + 1,
+        LabelRole,
+        CountRole,
+        SuperiorRole,
+        ProbabilityRole,
+        ExpectedRole
+    };
+
+    // In display order
+    enum class Section : quint8 {
+        Type,
+        Capacity,
+        Discipline,
+        Card,
+    };
+
+    explicit DeckStatsModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Rebuilds every row in a single model reset
+    void reset(const DeckContents& contents);
+    // Copies of a card were added (delta > 0) or removed; called after the deck changed
+    void applyChange(const Card& card, int delta);
+
+    double getAverageCapacity() const { return capacity_cards > 0 ? double(capacity_total) / capacity_cards : 0.0; }
+    double getLastUpdateUs() const { return last_update_us; }
+
+signals:
+    void statsChanged();
+
+private:
+    struct Row
+    {
+        // Sort key: key is the type bit, capacity or discipline, and for cards 0 in the crypt, 1 in the library
+        Section section = Section::Type;
+        int key = 0;
+        QString name;
+        quint32 card_id = 0;
+
+        QString label;
+        int count = 0;
+        int superior = 0;
+        double probability = 0.0;
+        double expected = 0.0;
+        bool dirty = false; // Count changed since the last refresh
+
+        bool isCrypt() const;
+    };
+
+    QList<Row> rows;
+    int library_size = 0;
+    int crypt_size = 0;
+    qint64 capacity_total = 0;
+    int capacity_cards = 0; // Crypt copies with a known capacity
+    double last_update_us = 0.0;
+
+    void countCard(const Card& card, int delta, bool notify);
+    void adjustRow(const Row& key, int delta, int superior_delta, bool notify);
+    void refresh(bool library_changed, bool crypt_changed, bool notify);
+
+    static bool lessThan(const Row& a, const Row& b);
+    static QString labelFor(const Row& row);
+    static QString sectionName(Section section);
+};
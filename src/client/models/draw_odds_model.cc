@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "draw_odds_model.h"
+#include "models/card.h"
+#include <QRandomGenerator>
+#include <QThreadPool>
+#include <QTimer>
+
+namespace {
+
+constexpr int typeBits(Card::Type type)
+{
+    return static_cast<int>(type);
+}
+
+} // namespace
+
+// DrawOddsModel implementation
+DrawOddsModel::DrawOddsModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , queries(defaultQueries())
+    , update_timer(new QTimer(this))
+{
+    update_timer->setInterval(UPDATE_INTERVAL_MS);
+    connect(update_timer, &QTimer::timeout, this, &DrawOddsModel::updateResults);
+}
+
+DrawOddsModel::~DrawOddsModel()
+{
+    // The workers only touch the run, which they keep alive, so it is enough to ask them to stop
+    if (!run.isNull()) {
+        run->stopped.storeRelaxed(1);
+    }
+}
+
+int DrawOddsModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent)
+    return queries.size();
+}
+
+QVariant DrawOddsModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= queries.size())
+        return QVariant();
+
+    switch (role) {
+    case LabelRole:
+        return queries[index.row()].label;
+    case ProbabilityRole:
+        return tally.probability(index.row());
+    case MarginRole:
+        return tally.margin(index.row());
+    }
+
+    return QVariant();
+}
+
+QHash<int, QByteArray> DrawOddsModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[LabelRole] = "label";
+    roles[ProbabilityRole] = "probability";
+    roles[MarginRole] = "margin";
+    return roles;
+}
+
+void DrawOddsModel::simulate(const DeckContents& contents)
+{
+    cancel();
+
+    DrawSimulation::Deck deck;
+    deck.library_types.reserve(contents.library_size);
+    deck.crypt_cards.reserve(contents.crypt_size);
+    for (int i = 0; i < contents.entries.size(); ++i) {
+        const DeckEntry& entry = contents.entries[i];
+        if (entry.card->isCrypt()) {
+            deck.crypt_cards.insert(deck.crypt_cards.size(), entry.quantity, quint16(i));
+        } else {
+            deck.library_types.insert(deck.library_types.size(), entry.quantity, typeBits(entry.card->getType()));
+        }
+    }
+
+    run = QSharedPointer<Run>::create();
+    run->simulation = DrawSimulation(deck, queries, QRandomGenerator::global()->generate64());
+    run->chunk_count = quint64((TRIALS + CHUNK_TRIALS - 1) / CHUNK_TRIALS);
+    tally = DrawSimulation::Tally();
+    trials_per_second = 0.0;
+
+    const int workers = qMax(1, QThreadPool::globalInstance()->maxThreadCount() - 1);
+    for (int i = 0; i < workers; ++i) {
+        QThreadPool::globalInstance()->start([run]() { work(run); });
+    }
+    run_clock.start();
+    update_timer->start();
+    emit runningChanged();
+    updateResults();
+}
+
+void DrawOddsModel::cancel()
+{
+    if (run.isNull()) {
+        return;
+    }
+    run->stopped.storeRelaxed(1);
+    run.reset();
+    update_timer->stop();
+    emit runningChanged();
+}
+
+void DrawOddsModel::updateResults()
+{
+    if (run.isNull()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&run->mutex);
+        tally = run->total;
+    }
+    const qint64 elapsed_ns = run_clock.nsecsElapsed();
+    trials_per_second = elapsed_ns > 0 ? tally.trials * 1e9 / elapsed_ns : 0.0;
+    if (!queries.isEmpty()) {
+        emit dataChanged(index(0), index(queries.size() - 1), {ProbabilityRole, MarginRole});
+    }
+    emit resultsChanged();
+
+    if (run->done_chunks.loadAcquire() == run->chunk_count) {
+        run.reset();
+        update_timer->stop();
+        emit runningChanged();
+    }
+}
+
+void DrawOddsModel::work(const QSharedPointer<Run>& run)
+{
+    const qint64 trials_left_for_last = TRIALS - qint64(run->chunk_count - 1) * CHUNK_TRIALS;
+    while (!run->stopped.loadRelaxed()) {
+        const quint64 chunk = run->next_chunk.fetchAndAddRelaxed(1);
+        if (chunk >= run->chunk_count) {
+            return;
+        }
+        const int trials = chunk + 1 == run->chunk_count ? int(trials_left_for_last) : CHUNK_TRIALS;
+        const DrawSimulation::Tally result = run->simulation.runChunk(chunk, trials);
+        {
+            QMutexLocker locker(&run->mutex);
+            run->total.add(result);
+        }
+        run->done_chunks.fetchAndAddRelease(1);
+    }
+}
+
+QList<DrawQuery> DrawOddsModel::defaultQueries()
+{
+    // Opening hand: 7 library cards; opening crypt: 4 vampires
+    return {
+        {"3+ reactions in the opening hand", DrawQuery::Pile::Library, typeBits(Card::Type::Reaction), 3, 7},
+        {"A reaction in the opening hand", DrawQuery::Pile::Library, typeBits(Card::Type::Reaction), 1, 7},
+        {"A master in the opening hand", DrawQuery::Pile::Library, typeBits(Card::Type::Master), 1, 7},
+        {"3+ masters in the opening hand", DrawQuery::Pile::Library, typeBits(Card::Type::Master), 3, 7},
+        {"An action in the opening hand", DrawQuery::Pile::Library, typeBits(Card::Type::Action), 1, 7},
+        {"2+ combat cards in the opening hand", DrawQuery::Pile::Library, typeBits(Card::Type::Combat), 2, 7},
+        {"4 different vampires in the opening crypt", DrawQuery::Pile::Crypt, 0, 4, 4},
+        {"3+ different vampires in the opening crypt", DrawQuery::Pile::Crypt, 0, 3, 4},
+    };
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QSharedPointer>
+#include <qqmlregistration.h>
+#include "game/draw_simulation.h"
+#include "models/deck_contents.h"
+
+class QTimer;
+
+/*
+ * Opening draw odds of a deck, one row per DrawQuery, estimated by DrawSimulation on the global thread pool.
+ * Rows are updated several times a second while the run is going, the margin shrinking as trials add up.
+ *
+ * The workers take the next chunk of trials from a shared counter until none are left, so a fast thread simply
+ * takes more chunks. One pool thread is left free for deck loads and image decoding, and the GUI thread never
+ * waits for a worker; it only reads the totals from a timer, which keeps the wasm build responsive.
+ */
+class DrawOddsModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(qint64 trials READ getTrials NOTIFY resultsChanged)
+    Q_PROPERTY(double trialsPerSecond READ getTrialsPerSecond NOTIFY resultsChanged)
+
+public:
+    enum OddsRoles {
+        LabelRole = Qt::UserRole + 1,
+        ProbabilityRole,
+        MarginRole
+    };
+
+    static constexpr qint64 TRIALS = 2000000;
+    static constexpr int CHUNK_TRIALS = 8192;
+    static constexpr int UPDATE_INTERVAL_MS = 100;
+
+    explicit DrawOddsModel(QObject* parent = nullptr);
+    ~DrawOddsModel() override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Starts over for a deck, abandoning the run in flight
+    void simulate(const DeckContents& contents);
+    Q_INVOKABLE void cancel();
+
+    bool isRunning() const { return !run.isNull(); }
+    qint64 getTrials() const { return qint64(tally.trials); }
+    double getTrialsPerSecond() const { return trials_per_second; }
+
+    // Opening hand and crypt questions asked of every deck
+    static QList<DrawQuery> defaultQueries();
+
+signals:
+    void runningChanged();
+    void resultsChanged();
+
+private:
+    // Shared with the workers, which keep it alive until the last one returns
+    struct Run
+    {
+        DrawSimulation simulation;
+        quint64 chunk_count = 0;
+        QAtomicInteger<quint64> next_chunk = 0;
+        QAtomicInteger<quint64> done_chunks = 0;
+        QAtomicInt stopped = 0;
+        QMutex mutex;
+        DrawSimulation::Tally total; // Guarded by mutex
+    };
+
+    QList<DrawQuery> queries;
+    DrawSimulation::Tally tally; // As last shown
+    QSharedPointer<Run> run;
+    QTimer* update_timer;
+    QElapsedTimer run_clock;
+    double trials_per_second = 0.0;
+
+    void updateResults();
+    static void work(const QSharedPointer<Run>& run);
+};
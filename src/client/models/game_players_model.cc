@@ -4,12 +4,14 @@
  */
 
 #include "game_players_model.h"
+#include <QElapsedTimer>
 
 // GamePlayersModel implementation
 GamePlayersModel::GamePlayersModel(QObject* parent)
     : QAbstractListModel(parent)
 {
     loadSamplePlayers();
+    reindex();
 }
 
 int GamePlayersModel::rowCount(const QModelIndex& parent) const
@@ -29,7 +31,7 @@ QVariant GamePlayersModel::data(const QModelIndex& index, int role) const
     case NameRole:
         return player.name;
     case StatusRole:
-        return player.status;
+        return playerStatusToString(player.status);
     case LifeRole:
         return player.life;
     case HandSizeRole:
@@ -38,6 +40,10 @@ QVariant GamePlayersModel::data(const QModelIndex& index, int role) const
         return player.is_host;
     case AvatarRole:
         return player.avatar;
+    case PlayerIdRole:
+        return player.id;
+    case StatusCodeRole:
+        return static_cast<int>(player.status);
     }
 
     return QVariant();
@@ -52,38 +58,174 @@ QHash<int, QByteArray> GamePlayersModel::roleNames() const
     roles[HandSizeRole] = "handSize";
     roles[IsHostRole] = "isHost";
     roles[AvatarRole] = "avatar";
+    roles[PlayerIdRole] = "playerId";
+    roles[StatusCodeRole] = "statusCode";
     return roles;
 }
 
 void GamePlayersModel::updatePlayerStatus(const QString& player_name, const QString& status)
 {
-    for (int i = 0; i < players.size(); ++i) {
-        if (players[i].name == player_name) {
-            players[i].status = status;
-            QModelIndex idx = index(i);
-            emit dataChanged(idx, idx, {StatusRole});
-            break;
-        }
+    const int row = rowForName(player_name);
+    if (row >= 0) {
+        setStatus(players[row].id, playerStatusFromString(status));
     }
 }
 
 void GamePlayersModel::updatePlayerLife(const QString& player_name, int life)
 {
+    const int row = rowForName(player_name);
+    if (row >= 0) {
+        setLife(players[row].id, life);
+    }
+}
+
+void GamePlayersModel::setStatus(quint32 player_id, PlayerStatus status)
+{
+    const int row = rowForId(player_id);
+    if (row >= 0 && players[row].status != status) {
+        players[row].status = status;
+        rowChanged(row, {StatusRole, StatusCodeRole});
+    }
+}
+
+void GamePlayersModel::setLife(quint32 player_id, int life)
+{
+    const int row = rowForId(player_id);
+    if (row >= 0 && players[row].life != life) {
+        players[row].life = life;
+        rowChanged(row, {LifeRole});
+    }
+}
+
+void GamePlayersModel::setHandSize(quint32 player_id, int hand_size)
+{
+    const int row = rowForId(player_id);
+    if (row >= 0 && players[row].hand_size != hand_size) {
+        players[row].hand_size = hand_size;
+        rowChanged(row, {HandSizeRole});
+    }
+}
+
+void GamePlayersModel::beginUpdate()
+{
+    ++batch_depth;
+}
+
+void GamePlayersModel::commitUpdate()
+{
+    if (batch_depth > 0 && --batch_depth == 0) {
+        flushChanges();
+    }
+}
+
+void GamePlayersModel::rowChanged(int row, std::initializer_list<int> roles)
+{
+    if (batch_depth == 0) {
+        const QModelIndex idx = index(row);
+        emit dataChanged(idx, idx, QList<int>(roles));
+        return;
+    }
+
+    QList<int>& row_roles = pending_roles[row];
+    for (int role : roles) {
+        if (!row_roles.contains(role)) {
+            row_roles.append(role);
+        }
+    }
+}
+
+void GamePlayersModel::flushChanges()
+{
+    // Adjacent rows are merged into one range; the roles of a range are the union of its rows
+    int first_row = -1;
+    int last_row = -1;
+    QList<int> roles;
+    auto emitRange = [&]() {
+        if (first_row >= 0) {
+            emit dataChanged(index(first_row), index(last_row), roles);
+        }
+    };
+
+    for (auto it = pending_roles.cbegin(); it != pending_roles.cend(); ++it) {
+        if (first_row < 0 || it.key() != last_row + 1) {
+            emitRange();
+            first_row = it.key();
+            roles.clear();
+        }
+        last_row = it.key();
+        for (int role : it.value()) {
+            if (!roles.contains(role)) {
+                roles.append(role);
+            }
+        }
+    }
+    emitRange();
+    pending_roles.clear();
+}
+
+void GamePlayersModel::reindex()
+{
+    row_by_id.clear();
+    row_by_name.clear();
+    row_by_id.reserve(players.size());
+    row_by_name.reserve(players.size());
     for (int i = 0; i < players.size(); ++i) {
-        if (players[i].name == player_name) {
-            players[i].life = life;
-            QModelIndex idx = index(i);
-            emit dataChanged(idx, idx, {LifeRole});
-            break;
+        row_by_id.insert(players[i].id, i);
+        row_by_name.insert(players[i].name, i);
+    }
+}
+
+void GamePlayersModel::applySnapshot(const TableState& state)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // Pending changes refer to rows of the old table
+    pending_roles.clear();
+    beginResetModel();
+    players = state.players;
+    reindex();
+    endResetModel();
+
+    table_sequence = state.sequence;
+    last_apply_time_us = timer.nsecsElapsed() / 1000;
+    emit tableSequenceChanged();
+}
+
+bool GamePlayersModel::applyDelta(const TableDelta& delta)
+{
+    if (delta.base_sequence != table_sequence) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    {
+        // Views see one update per run of changed rows instead of one per field
+        Batch batch(this);
+        for (const PlayerDelta& change : delta.changes) {
+            if (change.fields & PlayerDelta::StatusField)
+                setStatus(change.player_id, change.status);
+            if (change.fields & PlayerDelta::LifeField)
+                setLife(change.player_id, change.life);
+            if (change.fields & PlayerDelta::HandSizeField)
+                setHandSize(change.player_id, change.hand_size);
         }
     }
+
+    table_sequence = delta.sequence;
+    last_apply_time_us = timer.nsecsElapsed() / 1000;
+    emit tableSequenceChanged();
+    return true;
 }
 
 void GamePlayersModel::loadSamplePlayers()
 {
     players = {
-        {"PlayerOne", "Ready", 20, 7, true, "https://placecats.com/128/128"},
-        {"ProPlayer", "Selecting Deck", 18, 5, false, "https://placecats.com/64/128"},
-        {"CurrentUser", "Selecting Deck", 20, 6, false, "https://placecats.com/64/64"}
+        /* Id, Name, Status, Pool, Hand Size, Host, Avatar */
+        {1, "PlayerOne", PlayerStatus::Ready, 20, 7, true, "https://placecats.com/128/128"},
+        {2, "ProPlayer", PlayerStatus::SelectingDeck, 18, 5, false, "https://placecats.com/64/128"},
+        {3, "CurrentUser", PlayerStatus::SelectingDeck, 20, 6, false, "https://placecats.com/64/64"}
     };
-}
\ No newline at end of file
+}
@@ -6,14 +6,20 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QHash>
+#include <QMap>
 #include <qqmlregistration.h>
 #include "game/game_player.h"
+#include "game/table_state.h"
 
 class GamePlayersModel : public QAbstractListModel
 {
     Q_OBJECT
     QML_ELEMENT
 
+    Q_PROPERTY(quint32 tableSequence READ getTableSequence NOTIFY tableSequenceChanged)
+    Q_PROPERTY(qint64 lastApplyTimeUs READ getLastApplyTimeUs NOTIFY tableSequenceChanged)
+
 public:
     enum PlayerRoles {
         NameRole = Qt::UserRole + 1,
@@ -21,7 +27,9 @@ public:
         LifeRole,
         HandSizeRole,
         IsHostRole,
-        AvatarRole
+        AvatarRole,
+        PlayerIdRole,
+        StatusCodeRole
     };
 
     explicit GamePlayersModel(QObject* parent = nullptr);
@@ -34,7 +42,68 @@ public:
     Q_INVOKABLE void updatePlayerStatus(const QString& player_name, const QString& status);
     Q_INVOKABLE void updatePlayerLife(const QString& player_name, int life);
 
+    // Field updates by player id; unknown ids and unchanged values are ignored
+    void setStatus(quint32 player_id, PlayerStatus status);
+    void setLife(quint32 player_id, int life);
+    void setHandSize(quint32 player_id, int hand_size);
+
+    /*
+     * Updates between beginUpdate and commitUpdate are collected and emitted on commit as one dataChanged per
+     * run of adjacent changed rows, with the roles changed in that run. Batches nest; the outermost commit emits.
+     */
+    Q_INVOKABLE void beginUpdate();
+    Q_INVOKABLE void commitUpdate();
+
+    // Scoped batch: GamePlayersModel::Batch batch(model); ... commits when it goes out of scope
+    class Batch
+    {
+    public:
+        explicit Batch(GamePlayersModel* model)
+            : model(model)
+        {
+            model->beginUpdate();
+        }
+        ~Batch() { model->commitUpdate(); }
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+    private:
+        GamePlayersModel* model;
+    };
+
+    // Replaces the table with a full server snapshot
+    void applySnapshot(const TableState& state);
+    // Applies a delta as a single dataChanged; false if it does not follow the current sequence
+    bool applyDelta(const TableDelta& delta);
+    // The table as shown, the counterpart of applySnapshot
+    TableState tableState() const { return {table_sequence, players}; }
+
+    // Seats are rows, in join order; -1 / empty for unknown players and seats
+    int seatOf(quint32 player_id) const { return rowForId(player_id); }
+    int seatOfName(const QString& name) const { return rowForName(name); }
+    QString nameAt(int seat) const { return seat >= 0 && seat < players.size() ? players[seat].name : QString(); }
+    quint32 idAt(int seat) const { return seat >= 0 && seat < players.size() ? players[seat].id : 0; }
+
+    quint32 getTableSequence() const { return table_sequence; }
+    qint64 getLastApplyTimeUs() const { return last_apply_time_us; }
+
+signals:
+    void tableSequenceChanged();
+
 private:
     QList<GamePlayer> players;
+    QHash<quint32, int> row_by_id;
+    QHash<QString, int> row_by_name;
+    quint32 table_sequence = 0;
+    qint64 last_apply_time_us = 0;
+
+    int batch_depth = 0;
+    QMap<int, QList<int>> pending_roles; // Changed roles per row of the open batch, ordered by row
+
+    int rowForId(quint32 player_id) const { return row_by_id.value(player_id, -1); }
+    int rowForName(const QString& name) const { return row_by_name.value(name, -1); }
+    void reindex();
+    void rowChanged(int row, std::initializer_list<int> roles);
+    void flushChanges();
     void loadSamplePlayers();
-};
\ No newline at end of file
+};
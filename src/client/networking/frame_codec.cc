@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "frame_codec.h"
+#include <QtEndian>
+#include <cstring>
+
+QByteArray FrameCodec::encode(const Message& message)
+{
+    QByteArray frame(HEADER_SIZE + message.payload.size(), Qt::Uninitialized);
+    uchar* header = reinterpret_cast<uchar*>(frame.data());
+    qToLittleEndian<quint32>(quint32(message.payload.size()), header);
+    const quint16 type = static_cast<quint16>(message.type) | (message.compressed ? COMPRESSED_FLAG : 0);
+    qToLittleEndian<quint16>(type, header + 4);
+    qToLittleEndian<quint32>(message.sequence, header + 6);
+    if (!message.payload.isEmpty()) {
+        memcpy(header + HEADER_SIZE, message.payload.constData(), message.payload.size());
+    }
+    return frame;
+}
+
+void FrameCodec::append(const QByteArray& bytes)
+{
+    if (error) {
+        return;
+    }
+    // Drop consumed frames before growing, so a long session does not keep shifting the whole buffer
+    if (read_offset > 0 && read_offset >= buffer.size() / 2) {
+        buffer.remove(0, read_offset);
+        read_offset = 0;
+    }
+    buffer.append(bytes);
+}
+
+bool FrameCodec::next(Message& message)
+{
+    if (error || buffer.size() - read_offset < HEADER_SIZE) {
+        return false;
+    }
+
+    const uchar* header = reinterpret_cast<const uchar*>(buffer.constData() + read_offset);
+    const quint32 payload_size = qFromLittleEndian<quint32>(header);
+    if (payload_size > MAX_PAYLOAD_SIZE) {
+        error = true;
+        return false;
+    }
+    if (buffer.size() - read_offset < HEADER_SIZE + qsizetype(payload_size)) {
+        return false;
+    }
+
+    const quint16 type = qFromLittleEndian<quint16>(header + 4);
+    message.type = static_cast<MessageType>(type & ~COMPRESSED_FLAG);
+    message.compressed = type & COMPRESSED_FLAG;
+    message.sequence = qFromLittleEndian<quint32>(header + 6);
+    message.payload = buffer.mid(read_offset + HEADER_SIZE, payload_size);
+    read_offset += HEADER_SIZE + payload_size;
+    if (read_offset == buffer.size()) {
+        buffer.clear();
+        read_offset = 0;
+    }
+    return true;
+}
+
+void FrameCodec::clear()
+{
+    buffer.clear();
+    read_offset = 0;
+    error = false;
+}
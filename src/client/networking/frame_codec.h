@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include "message.h"
+
+/*
+ * Length-prefixed binary framing of protocol messages, all integers little-endian:
+ *
+ *   quint32 payload length | quint16 message type | quint32 sequence | payload
+ *
+ * The top bit of the message type flags a compressed payload.
+ *
+ * The reading side accumulates whatever the transport delivered (TCP segments or WebSocket messages, which may
+ * hold partial or several frames) and hands out complete messages.
+ */
+class FrameCodec
+{
+public:
+    static constexpr int HEADER_SIZE = 10;
+    // Anything larger is treated as a corrupt or hostile stream
+    static constexpr quint32 MAX_PAYLOAD_SIZE = 4 * 1024 * 1024;
+    static constexpr quint16 COMPRESSED_FLAG = 0x8000;
+
+    static QByteArray encode(const Message& message);
+
+    void append(const QByteArray& bytes);
+    // Takes the next complete message out of the buffer, false when more bytes are needed or on error
+    bool next(Message& message);
+    bool hasError() const { return error; }
+    void clear();
+
+private:
+    QByteArray buffer;
+    qsizetype read_offset = 0;
+    bool error = false;
+};
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QIODevice>
+
+// Protocol revision, sent in Hello; the server rejects clients speaking another revision
+constexpr quint16 PROTOCOL_VERSION = 3;
+
+// Optional protocol features, announced by the client in Hello; the server answers with those it supports too
+enum ProtocolFeature : quint32 {
+    CompressionFeature = 0x01, // Large payloads may be sent zlib compressed, see PayloadCompression
+};
+
+// Wire ids of the protocol messages; only append, never renumber. Payload fields are listed per message.
+enum class MessageType : quint16 {
+    Invalid = 0,
+    Hello,     // client: quint16 version, QString player name, QString password, quint32 features
+    Welcome,   // server: quint32 session id, QString server name, QByteArray resume token, quint32 features
+    Error,     // server: QString reason, the connection is closed afterwards
+    Ping,      // either side: qint64 sender timestamp in ns, echoed back unchanged in Pong
+    Pong,      // qint64 timestamp of the Ping
+    LobbyChat, // QString sender, QString text; sent by clients without sender, broadcast by the server with it
+    GameChat,  // QString game, QString sender, QString text
+
+    // Lobby game list: a snapshot after login or on request, then deltas keyed by the game id
+    GameListRequest, // client: empty
+    GameList,        // server: QList<GameInfo> snapshot
+    GameAdded,       // server: GameInfo
+    GameRemoved,     // server: quint32 game id
+    GameUpdated,     // server: quint32 game id, qint32 current players, qint32 spectators
+    CreateGame,      // client: GameInfo, id and host are filled in by the server
+    JoinGame,        // client: quint32 game id, bool spectator; leaves the game joined before
+
+    // Game table: a snapshot on join and membership changes, then deltas; payloads are TableCodec bytes
+    TableSnapshot,        // server: TableCodec snapshot
+    TableDelta,           // server: TableCodec delta
+    TableSnapshotRequest, // client: empty, sent when a delta does not follow the local sequence
+    PlayerStatusChange,   // client: quint8 PlayerStatus of the sending player
+
+    // Session resume after a dropped connection, sent instead of Hello
+    Resume,         // client: quint16 version, quint32 session id, QByteArray resume token, quint32 last event sequence
+    Resumed,        // server: quint32 replayed event count, followed by the events after the client's last one
+    ResumeRejected, // server: empty, the session expired; the client logs in again with Hello
+
+    LeaveGame, // client: empty, leaves the game joined or hosted
+
+    // Turn order, validated by both sides with TurnMachine
+    TurnCommand, // client: quint8 TurnAction
+    TurnChanged, // server: TurnState, after every accepted command and membership change
+
+    // Deck shuffles: each player deals with DeckEngine::playerSeed(table seed, own id), nobody sends pile orders
+    DeckSeed, // server: quint64 table seed, when the game starts and with snapshots of a running game
+
+    // Game action log, the history behind the table and turn state, see game/action_log.h
+    GameActionEvent,  // server: quint32 action index, quint64 packed GameAction, after every accepted action
+    ActionLogRequest, // client: quint32 end index of the local log, sent when an action does not follow it
+    ActionLogTail,    // server: ActionLog tail, with every table snapshot and as the answer to a request
+    Count,
+};
+
+/*
+ * A single protocol message. Payload fields are written with QDataStream in a fixed stream version, so both
+ * sides agree on the encoding regardless of their Qt version:
+ *
+ *   Message message = Message::create(MessageType::LobbyChat, sender, text);
+ *   if (message.read(sender, text)) { ... }
+ */
+struct Message
+{
+    MessageType type = MessageType::Invalid;
+    // Set by the sender; from the server, events carry increasing numbers and replies to the connection itself 0
+    quint32 sequence = 0;
+    QByteArray payload;
+    bool compressed = false; // Payload is zlib compressed, flagged in the frame header
+
+    template <typename... Fields>
+    static Message create(MessageType type, const Fields&... fields)
+    {
+        Message message;
+        message.type = type;
+        QDataStream stream(&message.payload, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_0);
+        (stream << ... << fields);
+        return message;
+    }
+
+    // False when the payload is shorter than the requested fields or malformed
+    template <typename... Fields>
+    bool read(Fields&... fields) const
+    {
+        QDataStream stream(payload);
+        stream.setVersion(QDataStream::Qt_6_0);
+        (stream >> ... >> fields);
+        return stream.status() == QDataStream::Ok;
+    }
+};
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "message_dispatcher.h"
+#include <algorithm>
+
+void MessageDispatcher::subscribe(MessageType type, QObject* context, Handler handler)
+{
+    const size_t slot = static_cast<size_t>(type);
+    if (slot >= subscriptions.size() || !context) {
+        return;
+    }
+
+    const bool first_subscription = std::none_of(subscriptions.cbegin(), subscriptions.cend(),
+        [context](const QList<Subscription>& list) {
+            return std::any_of(list.cbegin(), list.cend(),
+                               [context](const Subscription& subscription) { return subscription.context == context; });
+        });
+    if (first_subscription) {
+        connect(context, &QObject::destroyed, this, [this, context]() { unsubscribe(context); });
+    }
+    subscriptions[slot].append({context, std::move(handler)});
+}
+
+void MessageDispatcher::unsubscribe(QObject* context)
+{
+    for (QList<Subscription>& list : subscriptions) {
+        list.removeIf([context](const Subscription& subscription) {
+            return subscription.context.isNull() || subscription.context == context;
+        });
+    }
+    disconnect(context, &QObject::destroyed, this, nullptr);
+}
+
+bool MessageDispatcher::dispatch(const Message& message) const
+{
+    const size_t slot = static_cast<size_t>(message.type);
+    if (slot >= subscriptions.size()) {
+        return false;
+    }
+
+    // Iterate a copy, handlers may subscribe or unsubscribe while they run
+    const QList<Subscription> handlers = subscriptions[slot];
+    bool handled = false;
+    for (const Subscription& subscription : handlers) {
+        if (subscription.context) {
+            subscription.handler(message);
+            handled = true;
+        }
+    }
+    return handled;
+}
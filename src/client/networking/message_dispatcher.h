@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <array>
+#include <functional>
+#include "message.h"
+
+/*
+ * Routes incoming messages to the handlers registered for their type. Handlers are tied to a context object and
+ * dropped with it, so controllers created and destroyed by QML do not have to unsubscribe themselves.
+ */
+class MessageDispatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Handler = std::function<void(const Message&)>;
+
+    using QObject::QObject;
+
+    void subscribe(MessageType type, QObject* context, Handler handler);
+    void unsubscribe(QObject* context);
+
+    // Returns false when nobody handles the message type
+    bool dispatch(const Message& message) const;
+
+private:
+    struct Subscription
+    {
+        QPointer<QObject> context;
+        Handler handler;
+    };
+
+    std::array<QList<Subscription>, static_cast<size_t>(MessageType::Count)> subscriptions;
+};
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "payload_compression.h"
+#include "frame_codec.h"
+#include <QElapsedTimer>
+#include <QtEndian>
+
+void PayloadCompression::Stats::add(const Stats& other)
+{
+    frames += other.frames;
+    raw_bytes += other.raw_bytes;
+    compressed_bytes += other.compressed_bytes;
+    cpu_ns += other.cpu_ns;
+}
+
+bool PayloadCompression::compress(Message& message, Stats* stats)
+{
+    if (message.compressed || message.payload.size() < THRESHOLD) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QByteArray compressed = qCompress(message.payload, LEVEL);
+    const qint64 elapsed = timer.nsecsElapsed();
+    if (stats) {
+        stats->cpu_ns += elapsed;
+    }
+    // Already compressed data (images, random tokens) grows, send it as it is
+    if (compressed.size() >= message.payload.size()) {
+        return false;
+    }
+
+    if (stats) {
+        ++stats->frames;
+        stats->raw_bytes += message.payload.size();
+        stats->compressed_bytes += compressed.size();
+    }
+    message.payload = std::move(compressed);
+    message.compressed = true;
+    return true;
+}
+
+bool PayloadCompression::decompress(Message& message, Stats* stats)
+{
+    if (!message.compressed) {
+        return true;
+    }
+    // qCompress output starts with the uncompressed size, check it before qUncompress allocates that much
+    if (message.payload.size() < 4
+        || qFromBigEndian<quint32>(message.payload.constData()) > FrameCodec::MAX_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QByteArray payload = qUncompress(message.payload);
+    if (payload.isEmpty()) {
+        return false;
+    }
+
+    if (stats) {
+        ++stats->frames;
+        stats->raw_bytes += payload.size();
+        stats->compressed_bytes += message.payload.size();
+        stats->cpu_ns += timer.nsecsElapsed();
+    }
+    message.payload = std::move(payload);
+    message.compressed = false;
+    return true;
+}
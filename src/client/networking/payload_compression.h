@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include "message.h"
+
+/*
+ * zlib compression of frame payloads (Qt's qCompress), used once both sides announced CompressionFeature. Only
+ * payloads of at least THRESHOLD bytes are compressed, and only kept compressed when that made them smaller;
+ * the frame header flags compressed payloads. The functions keep no state and can run on any thread.
+ */
+class PayloadCompression
+{
+public:
+    // Below this the zlib header and the CPU time outweigh the savings on typical messages
+    static constexpr int THRESHOLD = 512;
+    static constexpr int LEVEL = 6;
+
+    struct Stats
+    {
+        quint64 frames = 0;           // Payloads compressed or decompressed
+        quint64 raw_bytes = 0;        // Their size uncompressed
+        quint64 compressed_bytes = 0; // Their size compressed
+        qint64 cpu_ns = 0;
+
+        double ratio() const { return compressed_bytes > 0 ? double(raw_bytes) / compressed_bytes : 1.0; }
+        void add(const Stats& other);
+    };
+
+    // Compresses the payload in place; false when it was left raw
+    static bool compress(Message& message, Stats* stats = nullptr);
+    // Restores a compressed payload in place; false when it is corrupt or would exceed the frame size limit
+    static bool decompress(Message& message, Stats* stats = nullptr);
+};
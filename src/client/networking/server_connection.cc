@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "server_connection.h"
+#include "message_dispatcher.h"
+#include "transport.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QJSEngine>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <QtConcurrent>
+#include <algorithm>
+
+// ServerConnection implementation
+ServerConnection* ServerConnection::instance()
+{
+    static ServerConnection* connection = new ServerConnection(QCoreApplication::instance());
+    return connection;
+}
+
+ServerConnection* ServerConnection::create(QQmlEngine* qml_engine, QJSEngine* js_engine)
+{
+    Q_UNUSED(qml_engine)
+    Q_UNUSED(js_engine)
+    ServerConnection* connection = instance();
+    QJSEngine::setObjectOwnership(connection, QJSEngine::CppOwnership);
+    return connection;
+}
+
+ServerConnection::ServerConnection(QObject* parent)
+    : QObject(parent)
+    , transport(Transport::create(this))
+    , dispatcher(new MessageDispatcher(this))
+    , handshake_timer(new QTimer(this))
+    , ping_timer(new QTimer(this))
+    , chat_timer(new QTimer(this))
+    , reconnect_timer(new QTimer(this))
+{
+    clock.start();
+
+    handshake_timer->setSingleShot(true);
+    handshake_timer->setInterval(HANDSHAKE_TIMEOUT_MS);
+    connect(handshake_timer, &QTimer::timeout, this, [this]() { fail("Connection timed out."); });
+
+    ping_timer->setInterval(PING_INTERVAL_MS);
+    connect(ping_timer, &QTimer::timeout, this, &ServerConnection::ping);
+
+    chat_timer->setSingleShot(true);
+    connect(chat_timer, &QTimer::timeout, this, &ServerConnection::drainChatQueue);
+
+    reconnect_timer->setSingleShot(true);
+    connect(reconnect_timer, &QTimer::timeout, this, &ServerConnection::reconnect);
+
+    connect(transport, &Transport::opened, this, &ServerConnection::onOpened);
+    connect(transport, &Transport::received, this, &ServerConnection::onReceived);
+    connect(transport, &Transport::closed, this, &ServerConnection::onClosed);
+    connect(transport, &Transport::errorOccurred, this, &ServerConnection::fail);
+}
+
+void ServerConnection::connectToServer(const QString& host_, quint16 port_, const QString& player_name_,
+                                       const QString& password_)
+{
+    if (state != State::Disconnected) {
+        disconnectFromServer();
+    }
+
+    host = host_;
+    port = port_;
+    player_name = player_name_;
+    password = password_;
+    codec.clear();
+    next_sequence = 1;
+    features = 0;
+    connect_started_ns = clock.nsecsElapsed();
+
+    qDebug() << "Connecting to" << host << ":" << port << "as" << player_name;
+    setState(State::Connecting);
+    handshake_timer->start();
+    transport->open(host, port);
+}
+
+void ServerConnection::disconnectFromServer()
+{
+    handshake_timer->stop();
+    ping_timer->stop();
+    chat_timer->stop();
+    reconnect_timer->stop();
+    chat_queue.clear();
+    outgoing.clear();
+    // Leaving on purpose ends the session, it is not resumed
+    resume_token.clear();
+    reconnect_attempt = 0;
+    resuming = false;
+    replay_remaining = 0;
+    if (state == State::Disconnected) {
+        return;
+    }
+    setState(State::Disconnected);
+    transport->close();
+    emit disconnected();
+}
+
+void ServerConnection::send(Message message)
+{
+    if (state != State::Connected) {
+        qDebug() << "Not connected, dropping message" << static_cast<int>(message.type);
+        return;
+    }
+    sendFrame(message);
+}
+
+bool ServerConnection::sendChat(Message message)
+{
+    if (state != State::Connected) {
+        qDebug() << "Not connected, dropping chat message";
+        return false;
+    }
+
+    // Keep the order: while older messages wait for a token, new ones queue behind them
+    if (chat_queue.isEmpty() && chat_bucket.tryTake(clock.elapsed())) {
+        sendFrame(message);
+        ++chat_sent;
+        emit chatStatsChanged();
+        return true;
+    }
+
+    if (chat_queue.size() >= CHAT_QUEUE_LIMIT) {
+        ++chat_dropped;
+        emit chatStatsChanged();
+        emit chatThrottled();
+        return false;
+    }
+
+    chat_queue.enqueue(std::move(message));
+    ++chat_delayed;
+    emit chatStatsChanged();
+    if (!chat_timer->isActive()) {
+        chat_timer->start(int(chat_bucket.msUntilAvailable(clock.elapsed())));
+    }
+    return true;
+}
+
+void ServerConnection::drainChatQueue()
+{
+    while (!chat_queue.isEmpty() && chat_bucket.tryTake(clock.elapsed())) {
+        sendFrame(chat_queue.dequeue());
+        ++chat_sent;
+    }
+    emit chatStatsChanged();
+    if (!chat_queue.isEmpty()) {
+        chat_timer->start(int(chat_bucket.msUntilAvailable(clock.elapsed())));
+    }
+}
+
+void ServerConnection::ping()
+{
+    if (state == State::Connected) {
+        // A dropped network often goes unnoticed by the socket, the missing pongs tell
+        if (clock.nsecsElapsed() - last_received_ns > qint64(LIVENESS_TIMEOUT_MS) * 1000000) {
+            fail("The server stopped responding.");
+            return;
+        }
+        sendFrame(Message::create(MessageType::Ping, clock.nsecsElapsed()));
+    }
+}
+
+void ServerConnection::sendFrame(const Message& message)
+{
+    Message framed = message;
+    framed.sequence = next_sequence++;
+    const bool compress = hasFeature(CompressionFeature) && framed.payload.size() >= PayloadCompression::THRESHOLD;
+
+    OutgoingFrame frame;
+    if (compress && framed.payload.size() >= ASYNC_COMPRESSION_SIZE) {
+        frame.encoding = QtConcurrent::run(&ServerConnection::encodeFrame, framed, true);
+        frame.encoding.then(this, [this](const EncodedFrame&) { flushOutgoing(); });
+    } else {
+        frame.encoded = encodeFrame(framed, compress);
+    }
+    outgoing.enqueue(std::move(frame));
+    flushOutgoing();
+}
+
+void ServerConnection::flushOutgoing()
+{
+    bool stats_changed = false;
+    while (!outgoing.isEmpty()) {
+        OutgoingFrame& frame = outgoing.head();
+        if (frame.encoding.isValid()) {
+            if (!frame.encoding.isFinished()) {
+                break;
+            }
+            frame.encoded = frame.encoding.result();
+        }
+        if (frame.encoded.stats.cpu_ns > 0) {
+            sent_compression.add(frame.encoded.stats);
+            stats_changed = true;
+        }
+        transport->send(frame.encoded.bytes);
+        outgoing.dequeue();
+    }
+    if (stats_changed) {
+        emit compressionStatsChanged();
+    }
+}
+
+ServerConnection::EncodedFrame ServerConnection::encodeFrame(Message message, bool compress)
+{
+    EncodedFrame frame;
+    if (compress) {
+        PayloadCompression::compress(message, &frame.stats);
+    }
+    frame.bytes = FrameCodec::encode(message);
+    return frame;
+}
+
+double ServerConnection::getCompressionRatio() const
+{
+    PayloadCompression::Stats total = sent_compression;
+    total.add(received_compression);
+    return total.ratio();
+}
+
+void ServerConnection::onOpened()
+{
+    setState(State::Handshaking);
+    if (resuming) {
+        sendFrame(Message::create(MessageType::Resume, PROTOCOL_VERSION, session_id, resume_token, last_event_sequence));
+    } else {
+        sendFrame(Message::create(MessageType::Hello, PROTOCOL_VERSION, player_name, password,
+                                  quint32(CompressionFeature)));
+    }
+}
+
+void ServerConnection::onReceived(const QByteArray& bytes)
+{
+    last_received_ns = clock.nsecsElapsed();
+    codec.append(bytes);
+    Message message;
+    while (codec.next(message)) {
+        if (message.compressed) {
+            if (!PayloadCompression::decompress(message, &received_compression)) {
+                fail("Received a corrupt compressed frame from the server.");
+                return;
+            }
+            emit compressionStatsChanged();
+        }
+        handleMessage(message);
+        // A handler may have closed the connection
+        if (state == State::Disconnected) {
+            return;
+        }
+    }
+    if (codec.hasError()) {
+        fail("Received a corrupt frame from the server.");
+    }
+}
+
+void ServerConnection::onClosed()
+{
+    if (state == State::Disconnected || state == State::Reconnecting) {
+        return;
+    }
+    if (state == State::Connecting || state == State::Handshaking) {
+        fail("The server closed the connection.");
+        return;
+    }
+    fail("The connection to the server was lost.");
+}
+
+void ServerConnection::handleMessage(const Message& message)
+{
+    switch (message.type) {
+    case MessageType::Welcome:
+        if (state == State::Handshaking && message.read(session_id, server_name, resume_token, features)) {
+            const bool restarted = reconnect_attempt > 0;
+            handshake_timer->stop();
+            reconnect_attempt = 0;
+            resuming = false;
+            // Event numbers start over with every new session
+            last_event_sequence = 0;
+            connect_time_us = (clock.nsecsElapsed() - connect_started_ns) / 1000;
+            setState(State::Connected);
+            ping_timer->start();
+            if (restarted) {
+                emit sessionRestarted();
+            } else {
+                emit loggedIn();
+            }
+            ping();
+        }
+        return;
+    case MessageType::Resumed:
+        if (state == State::Handshaking && resuming && message.read(replay_remaining)) {
+            handshake_timer->stop();
+            reconnect_attempt = 0;
+            resuming = false;
+            replay_count = replay_remaining;
+            resume_started_ns = clock.nsecsElapsed();
+            setState(State::Connected);
+            ping_timer->start();
+            if (replay_remaining == 0) {
+                finishResume();
+            }
+        }
+        return;
+    case MessageType::ResumeRejected:
+        if (state == State::Handshaking && resuming) {
+            qDebug() << "Session" << session_id << "expired, logging in again";
+            resuming = false;
+            sendFrame(Message::create(MessageType::Hello, PROTOCOL_VERSION, player_name, password,
+                                      quint32(CompressionFeature)));
+        }
+        return;
+    case MessageType::Error: {
+        QString reason;
+        message.read(reason);
+        // Rejected on purpose, retrying would not help
+        resume_token.clear();
+        fail(reason.isEmpty() ? QString("The server rejected the connection.") : reason);
+        return;
+    }
+    case MessageType::Ping:
+        sendFrame(Message{MessageType::Pong, 0, message.payload});
+        return;
+    case MessageType::Pong: {
+        qint64 sent_ns = 0;
+        if (message.read(sent_ns)) {
+            rtt_us = (clock.nsecsElapsed() - sent_ns) / 1000;
+            // Exponentially weighted, like TCP's smoothed RTT
+            average_rtt_us = average_rtt_us == 0 ? rtt_us : (7 * average_rtt_us + rtt_us) / 8;
+            emit latencyChanged();
+        }
+        return;
+    }
+    default:
+        break;
+    }
+
+    if (state != State::Connected) {
+        return;
+    }
+    if (message.sequence != 0) {
+        if (message.sequence <= last_event_sequence) {
+            // Already seen before the connection dropped
+            return;
+        }
+        last_event_sequence = message.sequence;
+    }
+    if (!dispatcher->dispatch(message)) {
+        qDebug() << "Unhandled message type" << static_cast<int>(message.type);
+    }
+    if (replay_remaining > 0 && message.sequence != 0 && --replay_remaining == 0) {
+        finishResume();
+    }
+}
+
+void ServerConnection::finishResume()
+{
+    resume_time_us = (clock.nsecsElapsed() - resume_started_ns) / 1000;
+    emit resumed(int(replay_count));
+}
+
+void ServerConnection::scheduleReconnect()
+{
+    handshake_timer->stop();
+    ping_timer->stop();
+    chat_timer->stop();
+    chat_queue.clear();
+    outgoing.clear();
+
+    // Jittered so clients dropped together by a server hiccup do not all come back in the same instant
+    const int ceiling = std::min(RECONNECT_MAX_MS, RECONNECT_BASE_MS << std::min(reconnect_attempt, 8));
+    const int delay = ceiling / 2 + int(QRandomGenerator::global()->bounded(ceiling / 2 + 1));
+    ++reconnect_attempt;
+    state = State::Reconnecting;
+    emit stateChanged();
+    transport->close();
+
+    qDebug() << "Reconnecting in" << delay << "ms, attempt" << reconnect_attempt << "of" << RECONNECT_ATTEMPTS;
+    if (reconnect_attempt == 1) {
+        emit connectionLost();
+    }
+    reconnect_timer->start(delay);
+}
+
+void ServerConnection::reconnect()
+{
+    codec.clear();
+    outgoing.clear();
+    next_sequence = 1;
+    resuming = true;
+    replay_remaining = 0;
+    setState(State::Connecting);
+    handshake_timer->start();
+    transport->open(host, port);
+}
+
+void ServerConnection::fail(const QString& error)
+{
+    qDebug() << "Connection error:" << error;
+    if (state == State::Reconnecting) {
+        // The next attempt is already scheduled
+        return;
+    }
+    // A logged in session is resumed, up to RECONNECT_ATTEMPTS times in a row before giving up
+    if (!resume_token.isEmpty() && state != State::Disconnected && reconnect_attempt < RECONNECT_ATTEMPTS) {
+        scheduleReconnect();
+        return;
+    }
+
+    const bool was_connected = state != State::Disconnected;
+    disconnectFromServer();
+    if (was_connected) {
+        emit connectionFailed(error);
+    }
+}
+
+void ServerConnection::setState(State new_state)
+{
+    if (state != new_state) {
+        state = new_state;
+        emit stateChanged();
+    }
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QObject>
+#include <QQueue>
+#include <QString>
+#include <qqmlregistration.h>
+#include "frame_codec.h"
+#include "message.h"
+#include "payload_compression.h"
+#include "token_bucket.h"
+
+class MessageDispatcher;
+class QJSEngine;
+class QQmlEngine;
+class QTimer;
+class Transport;
+
+/*
+ * Client side of the server protocol.
+ *
+ * Owns the transport, turns received bytes into messages and hands them to the dispatcher, on which controllers
+ * subscribe to the message types they care about. Everything runs on the GUI thread's event loop without ever
+ * waiting on the socket. Connect time and ping round trips are measured for display and diagnostics.
+ *
+ * A connection that drops after login is reopened with jittered exponential backoff. The session is resumed with
+ * the token from Welcome and the sequence number of the last event received, and the server replays only the
+ * events missed in between, so models keep their state. If the session expired the client logs in again.
+ *
+ * Large payloads are compressed in both directions when the server supports it; the largest ones are compressed
+ * on the thread pool, with the frames behind them held back so they still go out in order.
+ */
+class ServerConnection : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+    Q_PROPERTY(State state READ getState NOTIFY stateChanged)
+    Q_PROPERTY(bool connected READ isConnected NOTIFY stateChanged)
+    Q_PROPERTY(QString serverName READ getServerName NOTIFY stateChanged)
+    Q_PROPERTY(qint64 connectTimeUs READ getConnectTimeUs NOTIFY stateChanged)
+    Q_PROPERTY(qint64 rttUs READ getRttUs NOTIFY latencyChanged)
+    Q_PROPERTY(qint64 averageRttUs READ getAverageRttUs NOTIFY latencyChanged)
+    Q_PROPERTY(int chatSent READ getChatSent NOTIFY chatStatsChanged)
+    Q_PROPERTY(int chatDelayed READ getChatDelayed NOTIFY chatStatsChanged)
+    Q_PROPERTY(int chatDropped READ getChatDropped NOTIFY chatStatsChanged)
+    Q_PROPERTY(int reconnectAttempt READ getReconnectAttempt NOTIFY stateChanged)
+    Q_PROPERTY(qint64 resumeTimeUs READ getResumeTimeUs NOTIFY resumed)
+    Q_PROPERTY(double compressionRatio READ getCompressionRatio NOTIFY compressionStatsChanged)
+    Q_PROPERTY(int compressedFrames READ getCompressedFrames NOTIFY compressionStatsChanged)
+    Q_PROPERTY(qint64 compressionCpuUs READ getCompressionCpuUs NOTIFY compressionStatsChanged)
+
+public:
+    enum class State {
+        Disconnected,
+        Connecting,
+        Handshaking,
+        Connected,
+        Reconnecting, // Waiting for the next reconnect attempt
+    };
+    Q_ENUM(State)
+
+    static constexpr int HANDSHAKE_TIMEOUT_MS = 10000;
+    static constexpr int PING_INTERVAL_MS = 5000;
+    // Without any frame from the server for this long the connection is considered dropped
+    static constexpr int LIVENESS_TIMEOUT_MS = 3 * PING_INTERVAL_MS;
+    // Reconnect delays double from the base up to the cap, each randomized between half and full length
+    static constexpr int RECONNECT_BASE_MS = 250;
+    static constexpr int RECONNECT_MAX_MS = 8000;
+    static constexpr int RECONNECT_ATTEMPTS = 8;
+    // Outgoing chat flow control: bursts of CHAT_BURST messages, then CHAT_RATE per second
+    static constexpr double CHAT_RATE = 2.0;
+    static constexpr double CHAT_BURST = 5.0;
+    // Messages waiting for a token beyond this are dropped
+    static constexpr int CHAT_QUEUE_LIMIT = 10;
+    // Outgoing payloads at least this large are compressed off the GUI thread
+    static constexpr int ASYNC_COMPRESSION_SIZE = 64 * 1024;
+
+    // Shared connection used by all controllers
+    static ServerConnection* instance();
+    static ServerConnection* create(QQmlEngine* qml_engine, QJSEngine* js_engine);
+
+    explicit ServerConnection(QObject* parent = nullptr);
+
+    State getState() const { return state; }
+    bool isConnected() const { return state == State::Connected; }
+    QString getServerName() const { return server_name; }
+    quint32 getSessionId() const { return session_id; }
+    qint64 getConnectTimeUs() const { return connect_time_us; }
+    qint64 getRttUs() const { return rtt_us; }
+    qint64 getAverageRttUs() const { return average_rtt_us; }
+    MessageDispatcher* getDispatcher() const { return dispatcher; }
+    int getChatSent() const { return chat_sent; }
+    int getChatDelayed() const { return chat_delayed; }
+    int getChatDropped() const { return chat_dropped; }
+    int getReconnectAttempt() const { return reconnect_attempt; }
+    qint64 getResumeTimeUs() const { return resume_time_us; }
+    bool hasFeature(ProtocolFeature feature) const { return features & feature; }
+    // Uncompressed over compressed size of all payloads sent and received compressed
+    double getCompressionRatio() const;
+    int getCompressedFrames() const { return int(sent_compression.frames + received_compression.frames); }
+    qint64 getCompressionCpuUs() const { return (sent_compression.cpu_ns + received_compression.cpu_ns) / 1000; }
+
+    void connectToServer(const QString& host, quint16 port, const QString& player_name, const QString& password);
+    Q_INVOKABLE void disconnectFromServer();
+
+    // Queues the message on the transport; dropped with a warning while not connected
+    void send(Message message);
+    // Like send(), but rate limited; returns false when the message was dropped
+    bool sendChat(Message message);
+    Q_INVOKABLE void ping();
+
+signals:
+    void stateChanged();
+    void latencyChanged();
+    void chatStatsChanged();
+    void compressionStatsChanged();
+    void chatThrottled();
+    void loggedIn();
+    void connectionFailed(const QString& error);
+    void disconnected();
+    // The connection dropped and is being reopened
+    void connectionLost();
+    // The session was resumed and the missed events have been dispatched
+    void resumed(int replayed_events);
+    // The session expired while reconnecting and a new one was started; state kept from the old one is stale
+    void sessionRestarted();
+
+private:
+    Transport* transport;
+    MessageDispatcher* dispatcher;
+    QTimer* handshake_timer;
+    QTimer* ping_timer;
+    QTimer* chat_timer;
+    QTimer* reconnect_timer;
+    FrameCodec codec;
+    State state = State::Disconnected;
+
+    QString host;
+    quint16 port = 0;
+    QString player_name;
+    QString password;
+    QString server_name;
+    quint32 session_id = 0;
+    quint32 next_sequence = 1;
+    quint32 features = 0; // Agreed on in Welcome, kept when the session is resumed
+
+    // Frames in send order; a frame compressed on the thread pool holds back the ones queued after it
+    struct EncodedFrame
+    {
+        QByteArray bytes;
+        PayloadCompression::Stats stats;
+    };
+    struct OutgoingFrame
+    {
+        QFuture<EncodedFrame> encoding; // Only set while compressed asynchronously
+        EncodedFrame encoded;
+    };
+    QQueue<OutgoingFrame> outgoing;
+    PayloadCompression::Stats sent_compression;
+    PayloadCompression::Stats received_compression;
+
+    // Session resume
+    QByteArray resume_token;
+    quint32 last_event_sequence = 0;
+    int reconnect_attempt = 0;
+    bool resuming = false;
+    quint32 replay_remaining = 0;
+    quint32 replay_count = 0;
+    qint64 resume_started_ns = 0;
+    qint64 resume_time_us = 0;
+    qint64 last_received_ns = 0;
+
+    // Monotonic clock for connect time and ping timestamps
+    QElapsedTimer clock;
+    qint64 connect_started_ns = 0;
+    qint64 connect_time_us = 0;
+    qint64 rtt_us = 0;
+    qint64 average_rtt_us = 0;
+
+    TokenBucket chat_bucket{CHAT_RATE, CHAT_BURST};
+    QQueue<Message> chat_queue;
+    int chat_sent = 0;
+    int chat_delayed = 0;
+    int chat_dropped = 0;
+
+    void setState(State new_state);
+    void sendFrame(const Message& message);
+    void flushOutgoing();
+    static EncodedFrame encodeFrame(Message message, bool compress);
+    void onOpened();
+    void onReceived(const QByteArray& bytes);
+    void onClosed();
+    void handleMessage(const Message& message);
+    void fail(const QString& error);
+    void drainChatQueue();
+    void scheduleReconnect();
+    void reconnect();
+    void finishResume();
+};
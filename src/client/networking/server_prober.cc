@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "server_prober.h"
+#include "frame_codec.h"
+#include "transport.h"
+#include <QTimer>
+#include <algorithm>
+
+struct ServerProber::Probe
+{
+    Transport* transport = nullptr;
+    QTimer* timeout = nullptr;
+    FrameCodec codec;
+    QElapsedTimer clock;
+};
+
+qint64 ServerProber::Stats::averageRttUs() const
+{
+    if (rtt_samples_us.isEmpty()) {
+        return -1;
+    }
+    qint64 total = 0;
+    for (qint64 sample : rtt_samples_us) {
+        total += sample;
+    }
+    return total / rtt_samples_us.size();
+}
+
+double ServerProber::Stats::availability() const
+{
+    if (attempts.isEmpty()) {
+        return 0.0;
+    }
+    return double(std::count(attempts.cbegin(), attempts.cend(), true)) / attempts.size();
+}
+
+ServerProber::ServerProber(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void ServerProber::probeAll(const QList<Endpoint>& endpoints)
+{
+    for (const Endpoint& endpoint : endpoints) {
+        if (probes.contains(endpoint.name) || endpoint.host.isEmpty()) {
+            continue;
+        }
+
+        Probe* probe = new Probe;
+        probe->transport = Transport::create(this);
+        probe->timeout = new QTimer(probe->transport);
+        probe->timeout->setSingleShot(true);
+        probes.insert(endpoint.name, probe);
+
+        const QString name = endpoint.name;
+        connect(probe->timeout, &QTimer::timeout, this, [this, name]() { finish(name, false, 0); });
+        connect(probe->transport, &Transport::errorOccurred, this, [this, name]() { finish(name, false, 0); });
+        connect(probe->transport, &Transport::opened, this, [probe]() {
+            // Only the ping round trip is measured, not the connection setup
+            probe->clock.start();
+            probe->transport->send(FrameCodec::encode(Message::create(MessageType::Ping, qint64(0))));
+        });
+        connect(probe->transport, &Transport::received, this, [this, probe, name](const QByteArray& bytes) {
+            probe->codec.append(bytes);
+            Message message;
+            while (probe->codec.next(message)) {
+                if (message.type == MessageType::Pong) {
+                    finish(name, true, probe->clock.nsecsElapsed() / 1000);
+                    return;
+                }
+            }
+        });
+
+        probe->timeout->start(PROBE_TIMEOUT_MS);
+        probe->transport->open(endpoint.host, endpoint.port);
+    }
+
+    if (probes.isEmpty()) {
+        emit allProbesFinished();
+    }
+}
+
+void ServerProber::finish(const QString& name, bool ok, qint64 rtt_us)
+{
+    Probe* probe = probes.take(name);
+    if (!probe) {
+        return;
+    }
+    probe->timeout->stop();
+    probe->transport->disconnect(this);
+    probe->transport->close();
+    probe->transport->deleteLater();
+    delete probe;
+
+    Stats& stats = server_stats[name];
+    stats.last_ok = ok;
+    stats.attempts.append(ok);
+    if (stats.attempts.size() > SAMPLE_COUNT) {
+        stats.attempts.removeFirst();
+    }
+    if (ok) {
+        stats.rtt_samples_us.append(rtt_us);
+        if (stats.rtt_samples_us.size() > SAMPLE_COUNT) {
+            stats.rtt_samples_us.removeFirst();
+        }
+    }
+
+    emit probeFinished(name, ok, rtt_us);
+    if (probes.isEmpty()) {
+        emit allProbesFinished();
+    }
+}
+
+QStringList ServerProber::rank(const QStringList& names) const
+{
+    QStringList ranked = names;
+    std::stable_sort(ranked.begin(), ranked.end(), [this](const QString& a, const QString& b) {
+        const Stats stats_a = server_stats.value(a);
+        const Stats stats_b = server_stats.value(b);
+        if (stats_a.last_ok != stats_b.last_ok) {
+            return stats_a.last_ok;
+        }
+        if (!stats_a.last_ok) {
+            return false;
+        }
+        return stats_a.averageRttUs() < stats_b.averageRttUs();
+    });
+    return ranked;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+/*
+ * Measures the saved servers: every refresh opens a short-lived connection to each server at once, sends a single
+ * Ping and waits for the Pong or a timeout. Results are folded into rolling per-server statistics (RTT over the
+ * last few successful probes, availability over the last few attempts).
+ */
+class ServerProber : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Endpoint
+    {
+        QString name;
+        QString host;
+        quint16 port = 0;
+    };
+
+    struct Stats
+    {
+        QList<qint64> rtt_samples_us; // Newest last, at most SAMPLE_COUNT
+        QList<bool> attempts;         // Newest last, at most SAMPLE_COUNT
+        bool last_ok = false;
+
+        qint64 averageRttUs() const;
+        double availability() const;
+    };
+
+    static constexpr int PROBE_TIMEOUT_MS = 3000;
+    static constexpr int SAMPLE_COUNT = 5;
+
+    explicit ServerProber(QObject* parent = nullptr);
+
+    // Starts a probe of every endpoint; endpoints still being probed from an earlier call are skipped
+    void probeAll(const QList<Endpoint>& endpoints);
+    bool isProbing() const { return !probes.isEmpty(); }
+
+    Stats stats(const QString& name) const { return server_stats.value(name); }
+    // Healthy servers by ascending RTT, then the ones that did not answer
+    QStringList rank(const QStringList& names) const;
+
+signals:
+    void probeFinished(const QString& name, bool ok, qint64 rtt_us);
+    void allProbesFinished();
+
+private:
+    struct Probe;
+
+    QHash<QString, Probe*> probes;
+    QHash<QString, Stats> server_stats;
+
+    void finish(const QString& name, bool ok, qint64 rtt_us);
+};
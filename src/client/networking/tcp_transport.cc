@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "tcp_transport.h"
+#include <QTcpSocket>
+
+TcpTransport::TcpTransport(QObject* parent)
+    : Transport(parent)
+    , socket(new QTcpSocket(this))
+{
+    connect(socket, &QTcpSocket::connected, this, [this]() {
+        // Messages are small and latency bound, do not let Nagle hold them back
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        emit opened();
+    });
+    connect(socket, &QTcpSocket::disconnected, this, &Transport::closed);
+    connect(socket, &QTcpSocket::readyRead, this, [this]() { emit received(socket->readAll()); });
+    connect(socket, &QTcpSocket::errorOccurred, this, [this](QAbstractSocket::SocketError) {
+        emit errorOccurred(socket->errorString());
+    });
+}
+
+void TcpTransport::open(const QString& host, quint16 port)
+{
+    socket->abort();
+    socket->connectToHost(host, port);
+}
+
+void TcpTransport::close()
+{
+    socket->disconnectFromHost();
+}
+
+void TcpTransport::send(const QByteArray& bytes)
+{
+    // Buffered by QTcpSocket and flushed from the event loop, never blocks the caller
+    socket->write(bytes);
+}
+
+bool TcpTransport::isOpen() const
+{
+    return socket->state() == QAbstractSocket::ConnectedState;
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include "transport.h"
+
+class QTcpSocket;
+
+class TcpTransport : public Transport
+{
+    Q_OBJECT
+
+public:
+    explicit TcpTransport(QObject* parent = nullptr);
+
+    void open(const QString& host, quint16 port) override;
+    void close() override;
+    void send(const QByteArray& bytes) override;
+    bool isOpen() const override;
+
+private:
+    QTcpSocket* socket;
+};
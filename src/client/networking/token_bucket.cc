@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "token_bucket.h"
+#include <cmath>
+
+TokenBucket::TokenBucket(double rate, double burst)
+    : rate(rate)
+    , burst(burst)
+    , tokens(burst)
+{
+}
+
+bool TokenBucket::tryTake(qint64 now_ms)
+{
+    refill(now_ms);
+    if (tokens < 1.0) {
+        return false;
+    }
+    tokens -= 1.0;
+    return true;
+}
+
+qint64 TokenBucket::msUntilAvailable(qint64 now_ms)
+{
+    refill(now_ms);
+    if (tokens >= 1.0) {
+        return 0;
+    }
+    return qint64(std::ceil((1.0 - tokens) * 1000.0 / rate));
+}
+
+void TokenBucket::reset()
+{
+    tokens = burst;
+    last_refill_ms = -1;
+}
+
+void TokenBucket::refill(qint64 now_ms)
+{
+    if (last_refill_ms >= 0 && now_ms > last_refill_ms) {
+        tokens = qMin(burst, tokens + (now_ms - last_refill_ms) * rate / 1000.0);
+    }
+    last_refill_ms = now_ms;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+/*
+ * Token bucket rate limiter: allows bursts of up to `burst` operations, refilled at `rate` per second.
+ * Time is passed in by the caller (any monotonic millisecond clock), which keeps the bucket free of timers.
+ */
+class TokenBucket
+{
+public:
+    TokenBucket(double rate, double burst);
+
+    // Takes a token if one is available at now_ms
+    bool tryTake(qint64 now_ms);
+    // Milliseconds until the next token is available, 0 if one is available now
+    qint64 msUntilAvailable(qint64 now_ms);
+    void reset();
+
+private:
+    double rate;
+    double burst;
+    double tokens;
+    qint64 last_refill_ms = -1;
+
+    void refill(qint64 now_ms);
+};
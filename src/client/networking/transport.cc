@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "transport.h"
+
+#ifdef __EMSCRIPTEN__
+#include "websocket_transport.h"
+#else
+#include "tcp_transport.h"
+#endif
+
+Transport* Transport::create(QObject* parent)
+{
+#ifdef __EMSCRIPTEN__
+    return new WebSocketTransport(parent);
+#else
+    return new TcpTransport(parent);
+#endif
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+
+/*
+ * Byte stream to the server. Implementations are event driven on the thread they live in: open() and send()
+ * return immediately, results arrive through the signals. Received bytes carry no frame boundaries.
+ */
+class Transport : public QObject
+{
+    Q_OBJECT
+
+public:
+    using QObject::QObject;
+
+    // TCP on desktop, WebSocket in the browser where raw sockets are not available
+    static Transport* create(QObject* parent = nullptr);
+
+    virtual void open(const QString& host, quint16 port) = 0;
+    virtual void close() = 0;
+    virtual void send(const QByteArray& bytes) = 0;
+    virtual bool isOpen() const = 0;
+
+signals:
+    void opened();
+    void closed();
+    void received(const QByteArray& bytes);
+    void errorOccurred(const QString& error);
+};
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "websocket_transport.h"
+#include <QUrl>
+#include <QWebSocket>
+
+WebSocketTransport::WebSocketTransport(QObject* parent)
+    : Transport(parent)
+    , socket(new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this))
+{
+    connect(socket, &QWebSocket::connected, this, &Transport::opened);
+    connect(socket, &QWebSocket::disconnected, this, &Transport::closed);
+    connect(socket, &QWebSocket::binaryMessageReceived, this, &Transport::received);
+    connect(socket, &QWebSocket::errorOccurred, this, [this](QAbstractSocket::SocketError) {
+        emit errorOccurred(socket->errorString());
+    });
+}
+
+void WebSocketTransport::open(const QString& host, quint16 port)
+{
+    socket->abort();
+    if (host.contains("://")) {
+        socket->open(QUrl(host));
+    } else {
+        socket->open(QUrl(QString("ws://%1:%2/").arg(host).arg(port)));
+    }
+}
+
+void WebSocketTransport::close()
+{
+    socket->close();
+}
+
+void WebSocketTransport::send(const QByteArray& bytes)
+{
+    socket->sendBinaryMessage(bytes);
+}
+
+bool WebSocketTransport::isOpen() const
+{
+    return socket->state() == QAbstractSocket::ConnectedState;
+}
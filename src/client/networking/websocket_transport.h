@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include "transport.h"
+
+class QWebSocket;
+
+// Frames travel as binary WebSocket messages; used by the wasm build, which cannot open raw TCP sockets
+class WebSocketTransport : public Transport
+{
+    Q_OBJECT
+
+public:
+    explicit WebSocketTransport(QObject* parent = nullptr);
+
+    // host may be a full "ws://" or "wss://" URL, otherwise ws://host:port/ is used
+    void open(const QString& host, quint16 port) override;
+    void close() override;
+    void send(const QByteArray& bytes) override;
+    bool isOpen() const override;
+
+private:
+    QWebSocket* socket;
+};
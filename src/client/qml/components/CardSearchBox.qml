@@ -0,0 +1,75 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import SchreckNET_QML_PoC
+
+// Deck builder search box: fuzzy matches over the whole card database, click a result to add it to the deck
+ColumnLayout {
+    id: root
+    
+    property var deckModel: null
+    property int maximumResults: 8
+    
+    spacing: 2
+    
+    TextField {
+        id: searchField
+        Layout.fillWidth: true
+        placeholderText: "Search cards..."
+        selectByMouse: true
+        
+        onTextChanged: searchModel.query = text
+        Keys.onEscapePressed: text = ""
+        Keys.onReturnPressed: {
+            if (searchModel.count > 0 && root.deckModel) {
+                root.deckModel.addCard(searchModel.cardIdAt(0))
+            }
+        }
+    }
+    
+    ListView {
+        id: resultList
+        Layout.fillWidth: true
+        Layout.preferredHeight: Math.min(searchModel.count, root.maximumResults) * 22
+        visible: searchModel.count > 0
+        clip: true
+        boundsBehavior: Flickable.StopAtBounds
+        ScrollBar.vertical: ScrollBar { policy: ScrollBar.AsNeeded }
+        
+        model: CardSearchModel {
+            id: searchModel
+        }
+        
+        delegate: ItemDelegate {
+            required property int cardId
+            required property string name
+            required property string type
+            
+            width: ListView.view.width
+            height: 22
+            
+            contentItem: RowLayout {
+                spacing: 6
+                
+                Text {
+                    text: name
+                    font.pixelSize: 12
+                    elide: Text.ElideRight
+                    Layout.fillWidth: true
+                }
+                
+                Text {
+                    text: type
+                    font.pixelSize: 10
+                    color: "#7f8c8d"
+                }
+            }
+            
+            onClicked: {
+                if (root.deckModel) {
+                    root.deckModel.addCard(cardId)
+                }
+            }
+        }
+    }
+}
@@ -1,173 +1,168 @@
 import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
+import SchreckNET_QML_PoC
 
 GroupBox {
     id: root
     
-    property var cards: []
+    // DeckSectionModel with one row per distinct card
+    property var sectionModel: null
     
     title: getTotalCardCount() + " cards"
     
-    visible: cards && cards.length > 0
+    visible: getTotalCardCount() > 0
     
     Layout.fillWidth: true
     Layout.minimumWidth: parent ? parent.width : 0
     Layout.preferredWidth: parent ? parent.width : 0
     Layout.minimumHeight: 80
-    // Layout.preferredHeight: parent.height
+    // Grow with the section up to maximumGridHeight, the grid scrolls beyond that
+    property int maximumGridHeight: 400
+    Layout.preferredHeight: Math.min(cardGrid.contentHeight, maximumGridHeight) + topPadding + bottomPadding + 10
     
-    ScrollView {
+    // One delegate per visible copy; CardCopyModel expands the quantities on demand
+    GridView {
+        id: cardGrid
         anchors.fill: parent
         anchors.margins: 5
-        Layout.fillWidth: true
-        Layout.fillHeight: true
-        ScrollBar.vertical.policy: ScrollBar.AsNeeded
-        ScrollBar.horizontal.policy: ScrollBar.AsNeeded
+        clip: true
+        cellWidth: 46
+        cellHeight: 64
+        boundsBehavior: Flickable.StopAtBounds
+        ScrollBar.vertical: ScrollBar { policy: ScrollBar.AsNeeded }
         
-        Flow {
-            id: cardFlow
-            width: Math.max(parent.width, root.width - 20)
-            layoutDirection: Qt.LeftToRight
-            flow: Flow.LeftToRight
-            spacing: 2
+        model: CardCopyModel {
+            sourceModel: root.sectionModel
+        }
+        
+        delegate: Item {
+            width: 44
+            height: 62
             
-            Repeater {
-                model: root.cards
+            // Role values of this copy (name, type, imageUrl, imageSlug, quantity, copyIndex)
+            property var card: model
+            
+            Rectangle {
+                anchors.fill: parent
+                color: cardMouseArea.containsMouse ? "#e3f2fd" : "#f8f9fa"
+                border.color: getTypeColor(parent.card.rarity)
+                border.width: 2
+                radius: 4
                 
-                Repeater {
-                    id: innerRepeater
-                    model: modelData.quantity
-                    property var cardData: modelData
+                // Card Image with better debugging
+                Image {
+                    anchors.fill: parent
+                    anchors.margins: 2
+                    // Served by CardImageCache through the disk and memory tiers
+                    source: "image://cards/" + card.imageSlug
+                    // Decode straight to the tile size (scaled by the device pixel ratio by Qt Quick)
+                    sourceSize: Qt.size(width, height)
+                    fillMode: Image.PreserveAspectFit
+                    asynchronous: true
                     
-                    delegate: Item {
-                        width: 44
-                        height: 62
-                        
-                        property var card: innerRepeater.cardData
+                    Component.onCompleted: {
+                        console.log("Image component created for:", parent.card.name)
+                        console.log("Using source:", source)
+                    }
+                    
+                    onStatusChanged: {
+                        console.log("=== IMAGE STATUS CHANGE ===")
+                        console.log("Card:", card.name)
+                        console.log("Status:", status, "(0=Null, 1=Ready, 2=Loading, 3=Error)")
+                        console.log("Source:", source)
+                        console.log("Progress:", progress)
+                        console.log("Width:", width, "Height:", height)
+                        console.log("PaintedWidth:", paintedWidth, "PaintedHeight:", paintedHeight)
+                        console.log("========================")
+                    }
+                    
+                    onProgressChanged: {
+                        if (progress > 0) {
+                            console.log("Loading progress for", parent.card.name + ":", Math.round(progress * 100) + "%")
+                        }
+                    }
+                    
+                    // Default fallback - always visible with card name
+                    Rectangle {
+                        anchors.fill: parent
+                        color: parent.status === Image.Error ? "#ffebee" : 
+                               parent.status === Image.Loading ? "#fff3e0" : "#f0f0f0"
+                        visible: parent.status !== Image.Ready || parent.paintedWidth === 0
                         
-                        Rectangle {
-                            anchors.fill: parent
-                            color: cardMouseArea.containsMouse ? "#e3f2fd" : "#f8f9fa"
-                            border.color: getTypeColor(parent.card.rarity)
-                            border.width: 2
-                            radius: 4
+                        Column {
+                            anchors.centerIn: parent
+                            spacing: 1
                             
-                            // Card Image with better debugging
-                            Image {
-                                anchors.fill: parent
-                                anchors.margins: 2
-                                source: card.imageUrl
-                                fillMode: Image.PreserveAspectFit
-                                asynchronous: true
-                                cache: false  // Disable caching to force reload
-                                
-                                Component.onCompleted: {
-                                    console.log("Image component created for:", parent.card.name)
-                                    console.log("Using source:", source)
-                                }
-                                
-                                onStatusChanged: {
-                                    console.log("=== IMAGE STATUS CHANGE ===")
-                                    console.log("Card:", card.name)
-                                    console.log("Status:", status, "(0=Null, 1=Ready, 2=Loading, 3=Error)")
-                                    console.log("Source:", source)
-                                    console.log("Progress:", progress)
-                                    console.log("Width:", width, "Height:", height)
-                                    console.log("PaintedWidth:", paintedWidth, "PaintedHeight:", paintedHeight)
-                                    console.log("========================")
-                                }
-                                
-                                onProgressChanged: {
-                                    if (progress > 0) {
-                                        console.log("Loading progress for", parent.card.name + ":", Math.round(progress * 100) + "%")
-                                    }
-                                }
-                                
-                                // Default fallback - always visible with card name
-                                Rectangle {
-                                    anchors.fill: parent
-                                    color: parent.status === Image.Error ? "#ffebee" : 
-                                           parent.status === Image.Loading ? "#fff3e0" : "#f0f0f0"
-                                    visible: parent.status !== Image.Ready || parent.paintedWidth === 0
-                                    
-                                    Column {
-                                        anchors.centerIn: parent
-                                        spacing: 1
-                                        
-                                        Text {
-                                            text: parent.parent.status === Image.Error ? "ERR" :
-                                                  parent.parent.status === Image.Loading ? "..." : "?"
-                                            font.pixelSize: 8
-                                            color: parent.parent.status === Image.Error ? "#d32f2f" :
-                                                   parent.parent.status === Image.Loading ? "#ff9800" : "#666"
-                                            anchors.horizontalCenter: parent.horizontalCenter
-                                        }
-                                        
-                                        Text {
-                                            text: parent.parent.parent.card.name
-                                            font.pixelSize: 5
-                                            color: "#333"
-                                            wrapMode: Text.WordWrap
-                                            width: 38
-                                            horizontalAlignment: Text.AlignHCenter
-                                            maximumLineCount: 3
-                                        }
-                                    }
-                                }
+                            Text {
+                                text: parent.parent.status === Image.Error ? "ERR" :
+                                      parent.parent.status === Image.Loading ? "..." : "?"
+                                font.pixelSize: 8
+                                color: parent.parent.status === Image.Error ? "#d32f2f" :
+                                       parent.parent.status === Image.Loading ? "#ff9800" : "#666"
+                                anchors.horizontalCenter: parent.horizontalCenter
                             }
                             
-                            // Card name overlay (bottom)
-                            Rectangle {
-                                anchors.bottom: parent.bottom
-                                anchors.left: parent.left
-                                anchors.right: parent.right
-                                height: 14
-                                color: "#000000"
-                                opacity: 0.7
-                                visible: cardMouseArea.containsMouse
-                                
-                                Text {
-                                    anchors.centerIn: parent
-                                    text: parent.card.name
-                                    font.pixelSize: 8
-                                    color: "white"
-                                    elide: Text.ElideRight
-                                    maximumLineCount: 1
-                                }
-                            }
-                            
-                            MouseArea {
-                                id: cardMouseArea
-                                anchors.fill: parent
-                                hoverEnabled: true
-                                
-                                onClicked: {
-                                    console.log("=== CARD CLICKED ===")
-                                    // console.log("Card name:", parent.card.name)
-                                    // console.log("Type:", parent.card.type)
-                                    // console.log("imageUrl:", parent.card.imageUrl)
-                                    // console.log("Quantity:", parent.card.quantity)
-                                    console.log("Full card data:", JSON.stringify(parent.card))
-                                    console.log("==================")
-                                }
+                            Text {
+                                text: parent.parent.parent.card.name
+                                font.pixelSize: 5
+                                color: "#333"
+                                wrapMode: Text.WordWrap
+                                width: 38
+                                horizontalAlignment: Text.AlignHCenter
+                                maximumLineCount: 3
                             }
                         }
-                        
-                        // Tooltip with detailed info
-                        ToolTip {
-                            id: cardTooltip
-                            text: "Card: " + card.name + 
-                                  "\nType: " + card.type + 
-                                  "\nQuantity: " + card.quantity +
-                                  "\nImageURL: " + card.imageUrl +
-                                  "\nGenerated: " + getCardImageUrl(card.name)
-                                  //"\nFull card data:", JSON.stringify(card)
-                            visible: cardMouseArea.containsMouse
-                            delay: 300
-                        }
                     }
                 }
+                
+                // Card name overlay (bottom)
+                Rectangle {
+                    anchors.bottom: parent.bottom
+                    anchors.left: parent.left
+                    anchors.right: parent.right
+                    height: 14
+                    color: "#000000"
+                    opacity: 0.7
+                    visible: cardMouseArea.containsMouse
+                    
+                    Text {
+                        anchors.centerIn: parent
+                        text: parent.card.name
+                        font.pixelSize: 8
+                        color: "white"
+                        elide: Text.ElideRight
+                        maximumLineCount: 1
+                    }
+                }
+                
+                MouseArea {
+                    id: cardMouseArea
+                    anchors.fill: parent
+                    hoverEnabled: true
+                    
+                    onClicked: {
+                        console.log("=== CARD CLICKED ===")
+                        // console.log("Card name:", parent.card.name)
+                        // console.log("Type:", parent.card.type)
+                        // console.log("imageUrl:", parent.card.imageUrl)
+                        // console.log("Quantity:", parent.card.quantity)
+                        console.log("Full card data:", JSON.stringify(parent.card))
+                        console.log("==================")
+                    }
+                }
+            }
+            
+            // Tooltip with detailed info
+            ToolTip {
+                id: cardTooltip
+                text: "Card: " + card.name + 
+                      "\nType: " + card.type + 
+                      "\nQuantity: " + card.quantity +
+                      "\nImageURL: " + card.imageUrl
+                      //"\nFull card data:", JSON.stringify(card)
+                visible: cardMouseArea.containsMouse
+                delay: 300
             }
         }
     }
@@ -183,12 +178,6 @@ GroupBox {
     }
     
     function getTotalCardCount() {
-        var total = 0
-        if (cards) {
-            for (var i = 0; i < cards.length; i++) {
-                total += cards[i].quantity || 1
-            }
-        }
-        return total
+        return sectionModel ? sectionModel.totalCards : 0
     }
 }
@@ -148,12 +148,12 @@ Item {
                         
                         ListView {
                             id: chatListView
-                            model: lobbyController.chatHistory
+                            model: lobbyController.chatModel
                             spacing: 1
                             
                             delegate: Text {
                                 width: chatListView.width
-                                text: modelData
+                                text: kind === ChatModel.System ? "* " + model.text : "[" + sender + "]: " + model.text
                                 wrapMode: Text.Wrap
                                 padding: 4
                                 font.pixelSize: 12
@@ -294,13 +294,10 @@ Item {
         standardButtons: Dialog.Ok | Dialog.Cancel
         
         onAccepted: {
-            lobbyController.gameModel.addGame(
+            lobbyController.hostGame(
                 gameNameField.text || "New Game",
-                lobbyController.playerName,
                 formatCombo.currentText,
-                1, // Current players (host)
                 maxPlayersSpinner.value,
-                0, // Spectators
                 gamePasswordField.text.length > 0,
                 buddiesOnlyCheck.checked
             ) // Todo; add spectators only thing
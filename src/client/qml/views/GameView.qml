@@ -56,7 +56,7 @@ Item {
                                         }
 
                                         Text {
-                                                text: "Current: " + gameController.currentPlayer + " | Phase: " + gameController.gamePhase
+                                                text: "Turn " + gameController.turn + " | Current: " + gameController.currentPlayer + " | Phase: " + gameController.gamePhase
                                                 color: "#bdc3c7"
                                                 font.pixelSize: 12
                                         }
@@ -83,9 +83,17 @@ Item {
                                         }
 
 
+                                        Button {
+                                                text: "Next Phase"
+                                                enabled: gameController.isMyTurn
+                                                Layout.minimumWidth: 80
+                                                Layout.minimumHeight: 30
+                                                onClicked: gameController.nextPhase()
+                                        }
+
                                         Button {
                                                 text: "End Turn"
-                                                enabled: gameController.currentPlayer === "CurrentUser"
+                                                enabled: gameController.isMyTurn
                                                 Layout.minimumWidth: 80
                                                 Layout.minimumHeight: 30
                                                 onClicked: gameController.endTurn()
@@ -145,34 +153,133 @@ Item {
 
                                                 Item { Layout.fillWidth: true }
 
+                                                // Background deck load progress
+                                                ProgressBar {
+                                                        visible: gameController.deckLoading
+                                                        from: 0
+                                                        to: 100
+                                                        value: gameController.deckLoadProgress
+                                                        Layout.preferredWidth: 120
+                                                }
+
+                                                Button {
+                                                        text: "Cancel"
+                                                        visible: gameController.deckLoading
+                                                        Layout.minimumHeight: 24
+                                                        onClicked: gameController.cancelDeckLoad()
+                                                }
+
+                                                Text {
+                                                        text: "Total Cards: " + gameController.deckModel.cryptSize + "/" + gameController.deckModel.librarySize
+                                                        font.pixelSize: 12
+                                                        color: "#7f8c8d"
+                                                }
+
+                                                // Piles of the running game
                                                 Text {
-                                                        text: "Total Cards: " + gameController.deckModel.getCryptSize() + "/" + gameController.deckModel.getLibrarySize()
+                                                        visible: gameController.turn > 0
+                                                        text: "Crypt: " + gameController.cryptRemaining + " | Library: " + gameController.libraryRemaining + " | Hand: " + gameController.handCount + " | Ash Heap: " + gameController.ashHeapCount
                                                         font.pixelSize: 12
                                                         color: "#7f8c8d"
                                                 }
+
+                                                Button {
+                                                        text: "Draw"
+                                                        visible: gameController.turn > 0
+                                                        enabled: gameController.libraryRemaining > 0
+                                                        Layout.minimumHeight: 24
+                                                        onClicked: gameController.drawCard()
+                                                }
                                         }
                                 }
 
-                                // Card Display by Type
-                                ScrollView {
+                                // Deck builder search
+                                CardSearchBox {
+                                        Layout.fillWidth: true
+                                        deckModel: gameController.deckModel
+                                }
+
+                                // Card Display by Type, with the deck statistics next to it
+                                RowLayout {
                                         Layout.fillWidth: true
                                         Layout.fillHeight: true
-                                        Layout.minimumHeight: 400
+                                        spacing: 10
 
-                                        ColumnLayout {
-                                                width: parent.width
-                                                spacing: 15
+                                        ScrollView {
+                                                Layout.fillWidth: true
+                                                Layout.fillHeight: true
+                                                Layout.minimumHeight: 400
 
-                                                // Crypt Section
-                                                CardTypeSection {
-                                                        Layout.fillWidth: true
-                                                        title:  "Crypt"
-                                                        cards: gameController.deckModel.getCryptCards()
+                                                ColumnLayout {
+                                                        width: parent.width
+                                                        spacing: 15
+
+                                                        // Crypt Section
+                                                        CardTypeSection {
+                                                                Layout.fillWidth: true
+                                                                title:  "Crypt"
+                                                                sectionModel: gameController.deckModel.cryptModel
+                                                        }
+                                                        CardTypeSection {
+                                                                Layout.fillWidth: true
+                                                                title:  "Library"
+                                                                sectionModel: gameController.deckModel.libraryModel
+                                                        }
                                                 }
-                                                CardTypeSection {
-                                                        Layout.fillWidth: true
-                                                        title:  "Library"
-                                                        cards: gameController.deckModel.getLibraryCards()
+                                        }
+
+                                        // Exact deck statistics, kept up to date edit by edit
+                                        GroupBox {
+                                                title: "Deck Statistics"
+                                                Layout.fillHeight: true
+                                                Layout.preferredWidth: 260
+                                                Layout.minimumHeight: 400
+
+                                                ColumnLayout {
+                                                        anchors.fill: parent
+                                                        spacing: 5
+
+                                                        Text {
+                                                                text: "Average capacity: " + gameController.deckModel.statsModel.averageCapacity.toFixed(2) + " | Updated in " + gameController.deckModel.statsModel.lastUpdateUs.toFixed(1) + " us"
+                                                                font.pixelSize: 11
+                                                                color: "#7f8c8d"
+                                                                elide: Text.ElideRight
+                                                                Layout.fillWidth: true
+                                                        }
+
+                                                        ListView {
+                                                                id: deckStatsListView
+                                                                Layout.fillWidth: true
+                                                                Layout.fillHeight: true
+                                                                clip: true
+                                                                model: gameController.deckModel.statsModel
+
+                                                                section.property: "section"
+                                                                section.delegate: Text {
+                                                                        required property string section
+                                                                        text: section
+                                                                        font.bold: true
+                                                                        font.pixelSize: 12
+                                                                        topPadding: 6
+                                                                }
+
+                                                                delegate: RowLayout {
+                                                                        width: deckStatsListView.width
+
+                                                                        Text {
+                                                                                text: superior > 0 ? label + " (" + model.count + ", " + superior + " sup.)" : label + " (" + model.count + ")"
+                                                                                font.pixelSize: 12
+                                                                                elide: Text.ElideRight
+                                                                                Layout.fillWidth: true
+                                                                        }
+
+                                                                        Text {
+                                                                                text: (probability * 100).toFixed(1) + "%"
+                                                                                font.pixelSize: 12
+                                                                                color: "#7f8c8d"
+                                                                        }
+                                                                }
+                                                        }
                                                 }
                                         }
                                 }
@@ -210,6 +317,38 @@ Item {
                                         }
                                 }
 
+                                // Opening draw odds of the loaded deck, refined while the simulation runs
+                                GroupBox {
+                                        title: gameController.drawOddsModel.running ? "Draw Odds (" + gameController.drawOddsModel.trials + " shuffles...)" : "Draw Odds"
+                                        Layout.fillWidth: true
+                                        Layout.minimumHeight: 150
+                                        Layout.maximumHeight: 200
+
+                                        ListView {
+                                                id: drawOddsListView
+                                                anchors.fill: parent
+                                                clip: true
+                                                model: gameController.drawOddsModel
+
+                                                delegate: RowLayout {
+                                                        width: drawOddsListView.width
+
+                                                        Text {
+                                                                text: label
+                                                                font.pixelSize: 12
+                                                                elide: Text.ElideRight
+                                                                Layout.fillWidth: true
+                                                        }
+
+                                                        Text {
+                                                                text: (probability * 100).toFixed(1) + "% \u00b1 " + (margin * 100).toFixed(1)
+                                                                font.pixelSize: 12
+                                                                color: "#7f8c8d"
+                                                        }
+                                                }
+                                        }
+                                }
+
                                 // Chat Section
                                 GroupBox {
                                         title: "Game Chat"
@@ -230,12 +369,12 @@ Item {
 
                                                         ListView {
                                                                 id: chatListView
-                                                                model: gameController.chatHistory
+                                                                model: gameController.chatModel
                                                                 spacing: 1
 
                                                                 delegate: Text {
                                                                         width: chatListView.width
-                                                                        text: modelData
+                                                                        text: kind === ChatModel.System ? "* " + model.text : "[" + sender + "]: " + model.text
                                                                         wrapMode: Text.Wrap
                                                                         padding: 4
                                                                         font.pixelSize: 12
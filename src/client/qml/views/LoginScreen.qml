@@ -68,6 +68,13 @@ ScrollView {
                         }
                     }
                     
+                    // Measured latency of the selected server, the list is sorted fastest first
+                    Label {
+                        text: controller.probing ? "..." : (controller.serverLatency[hostsCombo.currentText] || "")
+                        color: text === "offline" ? "#d32f2f" : "#7f8c8d"
+                        Layout.minimumWidth: 50
+                    }
+                    
                     Button {
                         text: "\u21bb"
                         ToolTip.text: "Refresh server list"
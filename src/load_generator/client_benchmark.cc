@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "client_benchmark.h"
+#include "card_database/card_database.h"
+#include "card_database/card_search_index.h"
+#include "models/card.h"
+#include "models/deck_file_parser.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QStringList>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+namespace {
+
+// Display names per type bit, in bit order, as the baseline conversions spelled them out one by one
+constexpr const char* LEGACY_TYPE_NAMES[] = {
+    "Crypt", "Master", "Action", "Modifier", "Political Action", "Equipment", "Retainer",
+    "Ally", "Combat", "Reaction", "Event", "Power", "Conviction",
+};
+
+// Card::cardTypeToString before the slot table: a QStringList built and joined on every call
+QString legacyCardTypeToString(Card::Type type)
+{
+    QStringList type_strings;
+    for (int bit = 0; bit < int(std::size(LEGACY_TYPE_NAMES)); ++bit) {
+        if (static_cast<int>(type) & (1 << bit)) {
+            type_strings << LEGACY_TYPE_NAMES[bit];
+        }
+    }
+    if (type_strings.isEmpty())
+        return "Unknown";
+    return type_strings.join("/");
+}
+
+// Card::stringToCardType before the name table: string compares in bit order, then a split for compounds
+Card::Type legacyStringToCardType(const QString& typeStr)
+{
+    for (int bit = 0; bit < int(std::size(LEGACY_TYPE_NAMES)); ++bit) {
+        if (typeStr == LEGACY_TYPE_NAMES[bit]) {
+            return static_cast<Card::Type>(1 << bit);
+        }
+    }
+    if (typeStr.contains("/")) {
+        int combined_type = 0;
+        for (const QString& part : typeStr.split("/")) {
+            combined_type |= static_cast<int>(legacyStringToCardType(part.trimmed()));
+        }
+        return static_cast<Card::Type>(combined_type);
+    }
+    return Card::Type::Token;
+}
+
+// Every single type plus the combinations printed on real cards
+QList<Card::Type> cardTypes()
+{
+    QList<Card::Type> types;
+    for (int bit = 0; bit < int(std::size(LEGACY_TYPE_NAMES)); ++bit) {
+        types.append(static_cast<Card::Type>(1 << bit));
+    }
+    const int modifier = static_cast<int>(Card::Type::ActionModifier);
+    const int combat = static_cast<int>(Card::Type::Combat);
+    const int reaction = static_cast<int>(Card::Type::Reaction);
+    const int action = static_cast<int>(Card::Type::Action);
+    types << static_cast<Card::Type>(modifier | combat) << static_cast<Card::Type>(combat | reaction)
+          << static_cast<Card::Type>(modifier | reaction) << static_cast<Card::Type>(action | combat);
+    return types;
+}
+
+// Deck reading as DeckLoader did before DeckFileParser: decode to UTF-16, re-encode and build a QJsonDocument
+bool legacyParseDeck(const QString& file_path, DeckFileParser::Result& result)
+{
+    QFile file(file_path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+    QJsonDocument doc;
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        doc = QJsonDocument::fromJson(in.readAll().toUtf8());
+    }
+    if (doc.isNull() || !doc.isObject() || doc.isEmpty()) {
+        return false;
+    }
+
+    const QJsonObject obj = doc.object();
+    result.name = obj.value("name").toString();
+    result.author = obj.value("author").toString();
+    result.description = obj.value("description").toString();
+    for (const bool crypt : {true, false}) {
+        for (const QJsonValue& value : obj.value(crypt ? "crypt" : "library").toArray()) {
+            const QJsonObject card_object = value.toObject();
+            const quint32 id = quint32(card_object.value("id").toInt());
+            result.entries.append({id, card_object.value("count").toInt(), crypt});
+        }
+    }
+    return true;
+}
+
+// The read and parse steps of DeckLoader::loadContents
+bool mappedParseDeck(const QString& file_path, DeckFileParser::Result& result)
+{
+    QFile file(file_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QByteArray buffer;
+    QByteArrayView bytes;
+    if (const uchar* mapped = file.size() > 0 ? file.map(0, file.size()) : nullptr) {
+        bytes = QByteArrayView(mapped, file.size());
+    } else {
+        buffer = file.readAll();
+        bytes = buffer;
+    }
+    return DeckFileParser::parse(bytes, result);
+}
+
+// Same deck whatever order the file lists the sections in
+bool sameDeck(DeckFileParser::Result a, DeckFileParser::Result b)
+{
+    auto by_card = [](const DeckFileParser::Entry& x, const DeckFileParser::Entry& y) {
+        return std::tie(x.crypt, x.id, x.count) < std::tie(y.crypt, y.id, y.count);
+    };
+    std::sort(a.entries.begin(), a.entries.end(), by_card);
+    std::sort(b.entries.begin(), b.entries.end(), by_card);
+    return a.name == b.name && a.author == b.author && a.description == b.description
+        && std::equal(a.entries.cbegin(), a.entries.cend(), b.entries.cbegin(), b.entries.cend(),
+                      [](const DeckFileParser::Entry& x, const DeckFileParser::Entry& y) {
+                          return x.id == y.id && x.count == y.count && x.crypt == y.crypt;
+                      });
+}
+
+} // namespace
+
+namespace ClientBenchmark {
+
+bool runCardTypes(int rounds)
+{
+    const QList<Card::Type> types = cardTypes();
+    QStringList names;
+    int mismatches = 0;
+    for (Card::Type type : types) {
+        const QString name = Card::cardTypeToString(type);
+        names.append(name);
+        mismatches += legacyCardTypeToString(type) != name;
+        mismatches += legacyStringToCardType(name) != Card::stringToCardType(name);
+    }
+
+    // The sums keep the loops from being optimized away
+    qint64 sum = 0;
+    QElapsedTimer clock;
+    clock.start();
+    for (int round = 0; round < rounds; ++round) {
+        for (Card::Type type : types) {
+            sum += legacyCardTypeToString(type).size();
+        }
+    }
+    const qint64 legacy_to_ns = clock.nsecsElapsed();
+    clock.restart();
+    for (int round = 0; round < rounds; ++round) {
+        for (Card::Type type : types) {
+            sum += Card::cardTypeToString(type).size();
+        }
+    }
+    const qint64 table_to_ns = clock.nsecsElapsed();
+    clock.restart();
+    for (int round = 0; round < rounds; ++round) {
+        for (const QString& name : std::as_const(names)) {
+            sum += static_cast<int>(legacyStringToCardType(name));
+        }
+    }
+    const qint64 legacy_from_ns = clock.nsecsElapsed();
+    clock.restart();
+    for (int round = 0; round < rounds; ++round) {
+        for (const QString& name : std::as_const(names)) {
+            sum += static_cast<int>(Card::stringToCardType(name));
+        }
+    }
+    const qint64 table_from_ns = clock.nsecsElapsed();
+
+    const double conversions = double(rounds) * types.size();
+    qInfo().nospace() << "Card types, " << qint64(conversions) << " conversions each way: to string "
+                      << legacy_to_ns / conversions << " ns joined, " << table_to_ns / conversions
+                      << " ns from the table; from string " << legacy_from_ns / conversions << " ns compared, "
+                      << table_from_ns / conversions << " ns hashed (checksum " << sum << ")";
+    if (mismatches > 0) {
+        qWarning() << "Card types:" << mismatches << "conversions differ from the baseline";
+    }
+    return mismatches == 0;
+}
+
+bool runDeckImport(const QString& directory, int rounds)
+{
+    QStringList files;
+    const QDir dir(directory);
+    for (const QString& name : dir.entryList({"*.json"}, QDir::Files | QDir::Readable, QDir::Name)) {
+        files << dir.filePath(name);
+    }
+    if (files.isEmpty()) {
+        qWarning() << "Deck import: no *.json decks in" << directory;
+        return false;
+    }
+
+    int mismatches = 0;
+    for (const QString& file_path : std::as_const(files)) {
+        DeckFileParser::Result legacy;
+        DeckFileParser::Result mapped;
+        const bool legacy_ok = legacyParseDeck(file_path, legacy);
+        if (legacy_ok != mappedParseDeck(file_path, mapped) || (legacy_ok && !sameDeck(legacy, mapped))) {
+            qWarning() << "Deck import: the parsers disagree on" << file_path;
+            ++mismatches;
+        }
+    }
+
+    // The entry counts keep the loops from being optimized away
+    qint64 entries = 0;
+    QElapsedTimer clock;
+    clock.start();
+    for (int round = 0; round < rounds; ++round) {
+        for (const QString& file_path : std::as_const(files)) {
+            DeckFileParser::Result result;
+            legacyParseDeck(file_path, result);
+            entries += result.entries.size();
+        }
+    }
+    const qint64 legacy_ns = clock.nsecsElapsed();
+    clock.restart();
+    for (int round = 0; round < rounds; ++round) {
+        for (const QString& file_path : std::as_const(files)) {
+            DeckFileParser::Result result;
+            mappedParseDeck(file_path, result);
+            entries += result.entries.size();
+        }
+    }
+    const qint64 mapped_ns = clock.nsecsElapsed();
+    clock.restart();
+    for (int round = 0; round < rounds; ++round) {
+        entries += QtConcurrent::blockingMappedReduced<qint64>(
+            files,
+            [](const QString& file_path) {
+                DeckFileParser::Result result;
+                mappedParseDeck(file_path, result);
+                return result.entries.size();
+            },
+            [](qint64& total, qsizetype count) { total += count; });
+    }
+    const qint64 parallel_ns = clock.nsecsElapsed();
+
+    const double decks = double(rounds) * files.size();
+    auto decks_per_second = [decks](qint64 ns) { return ns > 0 ? decks * 1e9 / ns : 0.0; };
+    qInfo().nospace() << "Deck import, " << qint64(decks) << " decks: " << decks_per_second(legacy_ns)
+                      << " decks/s through QJsonDocument, " << decks_per_second(mapped_ns) << " decks/s mapped, "
+                      << decks_per_second(parallel_ns) << " decks/s mapped on "
+                      << QThreadPool::globalInstance()->maxThreadCount() << " threads (" << entries << " entries)";
+    return mismatches == 0;
+}
+
+bool runCardDatabase(const QString& file_path, int rounds)
+{
+    QElapsedTimer clock;
+    CardDatabase database;
+    clock.start();
+    if (!database.open(file_path)) {
+        qWarning() << "Card database: cannot open" << file_path;
+        return false;
+    }
+    const qint64 first_open_ns = clock.nsecsElapsed();
+
+    clock.restart();
+    for (int round = 0; round < rounds; ++round) {
+        CardDatabase reopened;
+        reopened.open(file_path);
+    }
+    const qint64 open_ns = clock.nsecsElapsed();
+
+    QList<quint32> ids;
+    ids.reserve(database.cardCount());
+    for (quint32 i = 0; i < database.cardCount(); ++i) {
+        ids.append(database.cardAt(i).id);
+    }
+    int mismatches = 0;
+    for (quint32 id : std::as_const(ids)) {
+        mismatches += database.lookup(id).id != id;
+    }
+
+    // The name lengths keep the loop from being optimized away
+    qint64 sum = 0;
+    clock.restart();
+    for (int round = 0; round < rounds; ++round) {
+        for (quint32 id : std::as_const(ids)) {
+            sum += database.lookup(id).name.size();
+        }
+    }
+    const qint64 lookup_ns = clock.nsecsElapsed();
+
+    clock.restart();
+    const CardSearchIndex index(database);
+    const qint64 index_ns = clock.nsecsElapsed();
+
+    const double lookups = double(rounds) * ids.size();
+    qInfo().nospace() << "Card database, " << database.cardCount() << " cards: first open " << first_open_ns / 1000.0
+                      << " us, open " << open_ns / 1000.0 / rounds << " us on average over " << rounds
+                      << " opens, lookup " << (lookups > 0 ? lookup_ns / lookups : 0.0) << " ns, search index "
+                      << index_ns / 1000.0 << " us for " << index.size() << " names (checksum " << sum << ")";
+    if (mismatches > 0) {
+        qWarning() << "Card database:" << mismatches << "ids do not look up to their own record";
+    }
+    return mismatches == 0;
+}
+
+} // namespace ClientBenchmark
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QString>
+
+/*
+ * Offline runs of client hot paths against the implementation they replaced, which is kept here as the baseline.
+ * Each prints its results with qInfo() and returns false when the two disagree on a result.
+ */
+namespace ClientBenchmark {
+
+// Card::Type to display string and back, the QStringList join and if-chain against the slot and name tables
+bool runCardTypes(int rounds);
+
+// Reads and parses every *.json deck of a directory, through QTextStream and QJsonDocument as deck loads used to
+// and through the mapped DeckFileParser, one thread each, then the mapped parser again on the whole pool
+bool runDeckImport(const QString& directory, int rounds);
+
+// Opens the card database at the given path over and over, then looks up every card id in it; the first open
+// of the run is reported on its own as the closest to a cold start. Also builds the card search index once.
+bool runCardDatabase(const QString& file_path, int rounds);
+
+} // namespace ClientBenchmark
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "engine_benchmark.h"
+#include "game/action_log.h"
+#include "game/deck_engine.h"
+#include "game/seeded_random.h"
+#include "models/deck_stats_model.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QList>
+#include <utility>
+
+namespace {
+
+constexpr int CRYPT_CARDS = 12;
+constexpr int LIBRARY_CARDS = 90;
+constexpr int TABLE_PLAYERS = 5;
+constexpr int GAME_LENGTHS[] = {1000, 10000, 100000, 1000000};
+constexpr int STATS_CHECK_INTERVAL = 1000;
+
+QList<quint32> cardIds(int count, quint32 first)
+{
+    QList<quint32> ids;
+    ids.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        ids.append(first + quint32(i));
+    }
+    return ids;
+}
+
+GameState startingTable()
+{
+    GameState state;
+    for (int i = 0; i < TABLE_PLAYERS; ++i) {
+        GamePlayer player;
+        player.id = quint32(i + 1);
+        player.name = QString("Player %1").arg(i + 1);
+        state.table.players.append(player);
+    }
+    return state;
+}
+
+// 12 vampires of mixed capacity and disciplines, 30 library cards of 3 copies spread over the types
+DeckContents statsDeck()
+{
+    DeckContents deck;
+    SeededRandom random(1);
+    for (int i = 0; i < CRYPT_CARDS; ++i) {
+        Card vampire(QString("Vampire %1").arg(i + 1), Card::Type::Crypt, QString());
+        vampire.setId(quint32(200001 + i));
+        vampire.setCapacity(1 + i % 11);
+        const quint64 disciplines = (1ull << random.bounded(Card::DISCIPLINE_COUNT)) | (1ull << (i % 8));
+        vampire.setDisciplines(disciplines, disciplines & (1ull << random.bounded(Card::DISCIPLINE_COUNT)));
+        deck.add(vampire, 1);
+    }
+    for (int i = 0; i < LIBRARY_CARDS / 3; ++i) {
+        const int type = 1 << (1 + i % 12);
+        Card card(QString("Library %1").arg(i + 1), static_cast<Card::Type>(type), QString());
+        card.setId(quint32(100001 + i));
+        deck.add(card, 3);
+    }
+    return deck;
+}
+
+bool sameRows(const DeckStatsModel& a, const DeckStatsModel& b)
+{
+    if (a.rowCount() != b.rowCount()) {
+        return false;
+    }
+    const QList<int> roles = a.roleNames().keys();
+    for (int row = 0; row < a.rowCount(); ++row) {
+        for (int role : roles) {
+            if (a.data(a.index(row), role) != b.data(b.index(row), role)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The active player moves through the phases, now and then someone changes their status
+GameAction nextAction(const GameState& state, int number)
+{
+    if (number % 7 == 6) {
+        return GameAction::status(state.table.players[number % TABLE_PLAYERS].id, PlayerStatus::Playing);
+    }
+    return GameAction::turn(state.table.players[state.turn.active_seat].id, TurnAction::NextPhase);
+}
+
+} // namespace
+
+namespace EngineBenchmark {
+
+bool runDeck(int rounds)
+{
+    const QList<quint32> crypt = cardIds(CRYPT_CARDS, 1);
+    const QList<quint32> library = cardIds(LIBRARY_CARDS, 1000);
+    DeckEngine engine;
+    DeckEngine check;
+    qint64 shuffled_cards = 0;
+    qint64 draws = 0;
+    qint64 check_ns = 0;
+    int mismatches = 0;
+
+    QElapsedTimer clock;
+    clock.start();
+    for (int round = 0; round < rounds; ++round) {
+        const quint64 seed = DeckEngine::playerSeed(quint64(round), 1);
+        engine.reset(crypt, library, seed);
+        shuffled_cards += CRYPT_CARDS + LIBRARY_CARDS;
+        draws += DeckEngine::OPENING_CRYPT + DeckEngine::OPENING_HAND;
+        while (engine.size(DeckEngine::Zone::Library) > 0) {
+            engine.draw();
+            engine.discard(0);
+            draws += 1;
+        }
+
+        // Not part of the timed work
+        const qint64 check_start = clock.nsecsElapsed();
+        check.reset(crypt, library, seed);
+        while (check.size(DeckEngine::Zone::Library) > 0) {
+            check.draw();
+            check.discard(0);
+        }
+        if (check.checksum() != engine.checksum()) {
+            ++mismatches;
+        }
+        check_ns += clock.nsecsElapsed() - check_start;
+    }
+    const double seconds = qMax<qint64>(1, clock.nsecsElapsed() - check_ns) / 1e9;
+
+    qInfo().nospace() << "Deck engine: " << rounds << " deals in " << seconds * 1000 << " ms, "
+                      << rounds / seconds << " deals/s, " << shuffled_cards / seconds << " cards shuffled/s, "
+                      << draws / seconds << " draws/s";
+    if (mismatches > 0) {
+        qWarning() << "Deck engine:" << mismatches << "deals did not reproduce from their seed";
+    }
+    return mismatches == 0;
+}
+
+bool runActionLog(int rounds)
+{
+    bool consistent = true;
+    for (int length : GAME_LENGTHS) {
+        ActionLog log;
+        log.checkpoint(startingTable());
+        log.append(GameAction::turn(1, TurnAction::StartGame));
+        QList<quint64> history; // Everything, where the log compacts
+        history.reserve(length);
+        history.append(GameAction::turn(1, TurnAction::StartGame).pack());
+
+        QElapsedTimer clock;
+        clock.start();
+        for (int i = 1; i < length; ++i) {
+            const GameAction action = nextAction(log.head(), i);
+            consistent &= log.append(action);
+            history.append(action.pack());
+        }
+        const double append_ns = double(clock.nsecsElapsed()) / length;
+
+        qint64 tail_ns = 0;
+        qint64 full_ns = 0;
+        qsizetype tail_bytes = 0;
+        for (int round = 0; round < rounds; ++round) {
+            clock.restart();
+            const QByteArray tail = log.encodeFromSnapshot();
+            ActionLog joined;
+            consistent &= joined.applyTail(tail);
+            tail_ns += clock.nsecsElapsed();
+            tail_bytes = tail.size();
+            consistent &= ActionLog::encodeState(joined.head()) == ActionLog::encodeState(log.head());
+
+            clock.restart();
+            GameState replayed = startingTable();
+            for (quint64 record : std::as_const(history)) {
+                GameAction action;
+                GameAction::unpack(record, action);
+                GameRules::apply(replayed, action);
+            }
+            full_ns += clock.nsecsElapsed();
+            consistent &= ActionLog::encodeState(replayed) == ActionLog::encodeState(log.head());
+        }
+
+        qInfo().nospace() << "Action log, " << length << " actions: append " << append_ns << " ns/action, "
+                          << log.snapshotCount() << " snapshots retained from action " << log.firstIndex()
+                          << "; rebuild from snapshot " << tail_ns / rounds / 1000.0 << " us (" << tail_bytes
+                          << " bytes), full replay " << full_ns / rounds / 1000.0 << " us";
+    }
+    if (!consistent) {
+        qWarning() << "Action log: a rebuilt state differs from the log head";
+    }
+    return consistent;
+}
+
+bool runDeckStats(int rounds)
+{
+    DeckContents deck = statsDeck();
+    DeckStatsModel stats;
+    DeckStatsModel check;
+    stats.reset(deck);
+    const double reset_us = stats.getLastUpdateUs();
+
+    SeededRandom random(2);
+    double total_us = 0.0;
+    double max_us = 0.0;
+    int mismatches = 0;
+    for (int round = 0; round < rounds; ++round) {
+        // Entries stay in the deck, so the benchmark keeps touching the same rows
+        DeckEntry& entry = deck.entries[int(random.bounded(quint32(deck.entries.size())))];
+        const int delta = entry.quantity > 1 && random.bounded(2) == 0 ? -1 : 1;
+        entry.quantity += delta;
+        (entry.card->isCrypt() ? deck.crypt_size : deck.library_size) += delta;
+
+        stats.applyChange(*entry.card, delta);
+        total_us += stats.getLastUpdateUs();
+        max_us = qMax(max_us, stats.getLastUpdateUs());
+
+        if (round % STATS_CHECK_INTERVAL == STATS_CHECK_INTERVAL - 1 || round == rounds - 1) {
+            check.reset(deck);
+            mismatches += sameRows(stats, check) ? 0 : 1;
+        }
+    }
+
+    qInfo().nospace() << "Deck stats, " << stats.rowCount() << " rows: rebuild " << reset_us << " us, edit "
+                      << total_us / rounds << " us on average, " << max_us << " us at most over " << rounds
+                      << " edits";
+    if (mismatches > 0) {
+        qWarning() << "Deck stats:" << mismatches << "checks differed from a rebuilt model";
+    }
+    return mismatches == 0;
+}
+
+} // namespace EngineBenchmark
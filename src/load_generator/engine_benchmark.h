@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+/*
+ * Offline throughput runs of the shared game engines, without a server. Each prints its results with qInfo()
+ * and returns false when a determinism check failed.
+ */
+namespace EngineBenchmark {
+
+// Deals a 12 crypt / 90 library deck from a new seed per round and draws the whole library. Every seed is dealt
+// twice and the checksums compared, as a client and the server would
+bool runDeck(int rounds);
+
+// Plays games of growing length through an ActionLog and compares rebuilding the state from the latest
+// snapshot plus its tail, as a joining client does, against replaying every action from the start
+bool runActionLog(int rounds);
+
+// Edits a 12 crypt / 90 library deck one copy at a time through a DeckStatsModel, and now and then compares
+// every row against a model rebuilt from the deck
+bool runDeckStats(int rounds);
+
+} // namespace EngineBenchmark
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "load_generator.h"
+#include <QDebug>
+#include <QFile>
+#include <QTimer>
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+LoadGenerator::LoadGenerator(const Options& options, QObject* parent)
+    : QObject(parent)
+    , options(options)
+    , spawn_timer(new QTimer(this))
+    , report_timer(new QTimer(this))
+{
+    spawn_timer->setInterval(options.clients > 0 ? options.ramp_up_ms / options.clients : 0);
+    connect(spawn_timer, &QTimer::timeout, this, &LoadGenerator::spawnClient);
+
+    report_timer->setInterval(options.report_interval_s * 1000);
+    connect(report_timer, &QTimer::timeout, this, &LoadGenerator::report);
+}
+
+void LoadGenerator::start()
+{
+    qInfo().nospace() << "Starting " << options.clients << " clients against " << options.client.host << ":"
+                      << options.client.port << " over " << options.ramp_up_ms << " ms, running "
+                      << options.duration_s << " s";
+    baseline_memory = residentMemory();
+    run_clock.start();
+    interval_clock.start();
+    loadClock();
+    spawn_timer->start();
+    report_timer->start();
+    QTimer::singleShot(options.duration_s * 1000, this, &LoadGenerator::finish);
+}
+
+void LoadGenerator::spawnClient()
+{
+    if (clients.size() >= options.clients) {
+        spawn_timer->stop();
+        return;
+    }
+    auto* client = new SimulatedClient(clients.size(), options.client, &interval_stats, this);
+    clients.append(client);
+    client->start();
+}
+
+void LoadGenerator::report()
+{
+    const double seconds = interval_clock.restart() / 1000.0;
+    int connected = 0;
+    qint64 rtt_sum = 0;
+    for (const SimulatedClient* client : std::as_const(clients)) {
+        if (client->isConnected()) {
+            ++connected;
+            rtt_sum += client->getAverageRttUs();
+        }
+    }
+    const qint64 memory_per_client = clients.isEmpty() ? 0 : (residentMemory() - baseline_memory) / clients.size();
+
+    qInfo().nospace() << "[" << run_clock.elapsed() / 1000.0 << " s] " << connected << "/" << options.clients
+                      << " clients connected, rtt avg " << (connected > 0 ? rtt_sum / connected : 0) << " us, "
+                      << memory_per_client / 1024 << " KiB/client";
+    printStats(interval_stats, seconds);
+
+    run_stats.merge(interval_stats);
+    interval_stats.clear();
+}
+
+void LoadGenerator::finish()
+{
+    spawn_timer->stop();
+    report_timer->stop();
+    report();
+
+    qInfo() << "Summary of the whole run:";
+    printStats(run_stats, run_clock.elapsed() / 1000.0);
+    emit finished();
+}
+
+void LoadGenerator::printStats(const LoadStats& stats, double seconds) const
+{
+    auto percentiles = [](const LatencyHistogram& histogram) {
+        return QString("p50 %1 us, p99 %2 us (%3 samples)")
+            .arg(histogram.percentile(0.5))
+            .arg(histogram.percentile(0.99))
+            .arg(histogram.count());
+    };
+
+    qInfo().nospace().noquote() << "  in " << stats.messages_received / seconds << " msg/s, chat sent "
+                                << stats.chat_sent / seconds << "/s, " << stats.chat_dropped << " dropped, "
+                                << stats.connect_failures << " connect failures";
+    qInfo().nospace().noquote() << "  chat latency " << percentiles(stats.chat_latency);
+    qInfo().nospace().noquote() << "  game list apply " << percentiles(stats.game_list_apply) << ", "
+                                << stats.games_hosted << " hosted, " << stats.games_joined << " joined, "
+                                << stats.games_left << " left";
+    qInfo().nospace().noquote() << "  table apply " << percentiles(stats.table_apply);
+    qInfo().nospace().noquote() << "  deck load " << percentiles(stats.deck_load) << ", " << stats.deck_failures
+                                << " failed";
+}
+
+qint64 LoadGenerator::residentMemory()
+{
+#ifdef Q_OS_LINUX
+    // Second field of statm: resident pages
+    QFile statm("/proc/self/statm");
+    if (statm.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1) {
+            return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+        }
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include "load_stats.h"
+#include "simulated_client.h"
+
+class QTimer;
+
+/*
+ * Starts the simulated clients spread over the ramp-up time, prints a report line per interval and a summary
+ * for the whole run when the duration is over.
+ */
+class LoadGenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options
+    {
+        SimulatedClient::Options client;
+        int clients = 100;
+        int ramp_up_ms = 5000;
+        int duration_s = 60;
+        int report_interval_s = 5;
+    };
+
+    explicit LoadGenerator(const Options& options, QObject* parent = nullptr);
+
+    void start();
+
+signals:
+    void finished();
+
+private:
+    Options options;
+    QList<SimulatedClient*> clients;
+    QTimer* spawn_timer;
+    QTimer* report_timer;
+    LoadStats interval_stats; // Written by the clients, cleared after every report
+    LoadStats run_stats;
+    QElapsedTimer run_clock;
+    QElapsedTimer interval_clock;
+    qint64 baseline_memory = 0;
+
+    void spawnClient();
+    void report();
+    void finish();
+    void printStats(const LoadStats& stats, double seconds) const;
+
+    // Resident set size of the process in bytes, 0 where it cannot be read
+    static qint64 residentMemory();
+};
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "load_stats.h"
+#include <QtAlgorithms>
+#include <cmath>
+
+// LatencyHistogram implementation
+void LatencyHistogram::add(qint64 us)
+{
+    ++counts[bucketOf(qMax<qint64>(0, us))];
+    ++total;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+}
+
+void LatencyHistogram::clear()
+{
+    counts.fill(0);
+    total = 0;
+}
+
+qint64 LatencyHistogram::percentile(double fraction) const
+{
+    if (total == 0) {
+        return 0;
+    }
+    const quint64 target = qMax<quint64>(1, quint64(std::ceil(fraction * total)));
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            return valueOf(i);
+        }
+    }
+    return valueOf(BUCKET_COUNT - 1);
+}
+
+int LatencyHistogram::bucketOf(qint64 us)
+{
+    if (us < SUB_BUCKETS) {
+        return int(us);
+    }
+    // Position of the highest bit, at least 4 here; the next 4 bits select the sub bucket
+    const int exponent = 63 - qCountLeadingZeroBits(quint64(us));
+    const int mantissa = int((us >> (exponent - 4)) & (SUB_BUCKETS - 1));
+    return (exponent - 3) * SUB_BUCKETS + mantissa;
+}
+
+qint64 LatencyHistogram::valueOf(int bucket)
+{
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    const int exponent = bucket / SUB_BUCKETS + 3;
+    const int mantissa = bucket % SUB_BUCKETS;
+    return qint64(SUB_BUCKETS + mantissa) << (exponent - 4);
+}
+
+// LoadStats implementation
+void LoadStats::merge(const LoadStats& other)
+{
+    messages_received += other.messages_received;
+    chat_sent += other.chat_sent;
+    chat_dropped += other.chat_dropped;
+    connect_failures += other.connect_failures;
+    games_hosted += other.games_hosted;
+    games_joined += other.games_joined;
+    games_left += other.games_left;
+    deck_loads += other.deck_loads;
+    deck_failures += other.deck_failures;
+    chat_latency.merge(other.chat_latency);
+    game_list_apply.merge(other.game_list_apply);
+    table_apply.merge(other.table_apply);
+    deck_load.merge(other.deck_load);
+}
+
+const QElapsedTimer& loadClock()
+{
+    static const QElapsedTimer clock = []() {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock;
+}
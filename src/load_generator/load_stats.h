@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+#include <array>
+
+/*
+ * Log-linear histogram of durations in microseconds: exact below 16 us, then 16 buckets per power of two, so
+ * percentiles are within about 6% while memory stays fixed no matter how many samples a run collects.
+ */
+class LatencyHistogram
+{
+public:
+    void add(qint64 us);
+    void merge(const LatencyHistogram& other);
+    void clear();
+    quint64 count() const { return total; }
+    // Lower bound of the bucket holding the given fraction (0-1) of the samples, 0 when empty
+    qint64 percentile(double fraction) const;
+
+private:
+    static constexpr int SUB_BUCKETS = 16;
+    static constexpr int BUCKET_COUNT = 64 * SUB_BUCKETS;
+
+    std::array<quint64, BUCKET_COUNT> counts{};
+    quint64 total = 0;
+
+    static int bucketOf(qint64 us);
+    static qint64 valueOf(int bucket);
+};
+
+// Counters shared by all simulated clients of a load run; everything runs on the main thread
+struct LoadStats
+{
+    quint64 messages_received = 0;
+    quint64 chat_sent = 0;
+    quint64 chat_dropped = 0;
+    quint64 connect_failures = 0;
+    quint64 games_hosted = 0;
+    quint64 games_joined = 0;
+    quint64 games_left = 0;
+    quint64 deck_loads = 0;
+    quint64 deck_failures = 0;
+
+    LatencyHistogram chat_latency;     // Send to receive of lobby chat, over every receiving client
+    LatencyHistogram game_list_apply;  // GameListModel update per game list message
+    LatencyHistogram table_apply;      // GamePlayersModel update per table message
+    LatencyHistogram deck_load;        // File to DeckModel
+
+    void merge(const LoadStats& other);
+    void clear() { *this = LoadStats(); }
+};
+
+// Monotonic clock shared by all clients, chat messages carry their send time on it
+const QElapsedTimer& loadClock();
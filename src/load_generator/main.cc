@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include "client_benchmark.h"
+#include "engine_benchmark.h"
+#include "load_generator.h"
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("SchreckNET load generator");
+    app.setApplicationVersion("0.1");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs simulated SchreckNET clients against a server and reports throughput, "
+                                     "latency and memory. Deck loads resolve cards through SCHRECKNET_CARD_DB.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption host_option("host", "Server host.", "host", "127.0.0.1");
+    QCommandLineOption port_option({"p", "port"}, "Server TCP port.", "port", "4747");
+    QCommandLineOption clients_option({"c", "clients"}, "Number of simulated clients.", "count", "100");
+    QCommandLineOption ramp_up_option("ramp-up", "Time over which the clients connect, in ms.", "ms", "5000");
+    QCommandLineOption duration_option({"d", "duration"}, "Length of the run, in seconds.", "s", "60");
+    QCommandLineOption interval_option("interval", "Average time between actions of a client, in ms.", "ms", "1000");
+    QCommandLineOption report_option("report", "Interval of the report lines, in seconds.", "s", "5");
+    QCommandLineOption deck_option("deck", "Deck file loaded by the clients, deck loads are skipped without.", "file");
+    QCommandLineOption bench_option("bench", "Runs an offline benchmark instead of clients: deck, action-log, "
+                                    "deck-stats, card-types, deck-import, card-db.", "name");
+    QCommandLineOption rounds_option("rounds", "Rounds of the benchmark, by default 1000000 deals, 20 rebuilds per "
+                                     "game length, 100000 deck edits, 100000 passes over the card types, 20 "
+                                     "passes over the decks or 1000 card database opens and lookup passes.", "count");
+    QCommandLineOption deck_dir_option("deck-dir", "Directory of *.json decks read by --bench deck-import.", "dir");
+    parser.addOptions({host_option, port_option, clients_option, ramp_up_option, duration_option, interval_option,
+                       report_option, deck_option, bench_option, rounds_option, deck_dir_option});
+    parser.process(app);
+
+    if (parser.isSet(bench_option)) {
+        const QString benchmark = parser.value(bench_option);
+        const bool rounds_set = parser.isSet(rounds_option);
+        const int rounds = qMax(1, parser.value(rounds_option).toInt());
+        if (benchmark == "deck") {
+            return EngineBenchmark::runDeck(rounds_set ? rounds : 1000000) ? 0 : 1;
+        }
+        if (benchmark == "action-log") {
+            return EngineBenchmark::runActionLog(rounds_set ? rounds : 20) ? 0 : 1;
+        }
+        if (benchmark == "deck-stats") {
+            return EngineBenchmark::runDeckStats(rounds_set ? rounds : 100000) ? 0 : 1;
+        }
+        if (benchmark == "card-types") {
+            return ClientBenchmark::runCardTypes(rounds_set ? rounds : 100000) ? 0 : 1;
+        }
+        if (benchmark == "deck-import") {
+            return ClientBenchmark::runDeckImport(parser.value(deck_dir_option), rounds_set ? rounds : 20) ? 0 : 1;
+        }
+        if (benchmark == "card-db") {
+            const QString path = qEnvironmentVariable("SCHRECKNET_CARD_DB");
+            return ClientBenchmark::runCardDatabase(path, rounds_set ? rounds : 1000) ? 0 : 1;
+        }
+        qCritical() << "Unknown benchmark" << benchmark;
+        return 2;
+    }
+
+    LoadGenerator::Options options;
+    options.client.host = parser.value(host_option);
+    options.client.port = parser.value(port_option).toUShort();
+    options.client.action_interval_ms = qMax(1, parser.value(interval_option).toInt());
+    options.client.deck_file = parser.value(deck_option);
+    options.clients = qMax(1, parser.value(clients_option).toInt());
+    options.ramp_up_ms = qMax(0, parser.value(ramp_up_option).toInt());
+    options.duration_s = qMax(1, parser.value(duration_option).toInt());
+    options.report_interval_s = qMax(1, parser.value(report_option).toInt());
+
+    LoadGenerator generator(options);
+    QObject::connect(&generator, &LoadGenerator::finished, &app, &QCoreApplication::quit);
+    generator.start();
+    return app.exec();
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "simulated_client.h"
+#include "controllers/game_lobby_controller.h"
+#include "game/table_state.h"
+#include "models/chat_model.h"
+#include "models/deck_loader.h"
+#include "models/deck_model.h"
+#include "models/game_players_model.h"
+#include "networking/message_dispatcher.h"
+#include "networking/server_connection.h"
+#include <QTimer>
+#include <iterator>
+
+namespace {
+
+// Relative weights of the actions, in Action order
+constexpr int ACTION_WEIGHTS[] = {40, 20, 15, 5, 10, 10};
+constexpr const char* CHAT_PREFIX = "load ";
+
+// Runs an update and records how long it took
+template <typename Update>
+void timed(LatencyHistogram& histogram, Update update)
+{
+    QElapsedTimer timer;
+    timer.start();
+    update();
+    histogram.add(timer.nsecsElapsed() / 1000);
+}
+
+} // namespace
+
+SimulatedClient::SimulatedClient(int index, const Options& options, LoadStats* stats, QObject* parent)
+    : QObject(parent)
+    , options(options)
+    , stats(stats)
+    , player_name(QString("LoadBot%1").arg(index))
+    , connection(new ServerConnection(this))
+    , game_list_model(new GameListModel(this))
+    , chat_model(new ChatModel(this))
+    , players_model(new GamePlayersModel(this))
+    , deck_model(new DeckModel(this))
+    , deck_loader(new DeckLoader(this))
+    , action_timer(new QTimer(this))
+    , random(quint32(index) + 1)
+{
+    action_timer->setSingleShot(true);
+    connect(action_timer, &QTimer::timeout, this, &SimulatedClient::act);
+
+    connect(connection, &ServerConnection::loggedIn, this, &SimulatedClient::scheduleAction);
+    connect(connection, &ServerConnection::connectionFailed, this, [this]() { ++stats->connect_failures; });
+    connect(connection, &ServerConnection::disconnected, action_timer, &QTimer::stop);
+
+    connect(deck_loader, &DeckLoader::loaded, this, [this](const DeckContents& contents) {
+        deck_model->setDeck(contents);
+        ++stats->deck_loads;
+        stats->deck_load.add(deck_timer.nsecsElapsed() / 1000);
+    });
+    connect(deck_loader, &DeckLoader::failed, this, [this]() { ++stats->deck_failures; });
+
+    subscribe();
+}
+
+void SimulatedClient::start()
+{
+    connection->connectToServer(options.host, options.port, player_name, QString());
+}
+
+bool SimulatedClient::isConnected() const
+{
+    return connection->isConnected();
+}
+
+qint64 SimulatedClient::getAverageRttUs() const
+{
+    return connection->getAverageRttUs();
+}
+
+void SimulatedClient::subscribe()
+{
+    MessageDispatcher* dispatcher = connection->getDispatcher();
+    for (int type = 1; type < static_cast<int>(MessageType::Count); ++type) {
+        dispatcher->subscribe(static_cast<MessageType>(type), this, [this](const Message&) {
+            ++stats->messages_received;
+        });
+    }
+
+    // The same handling as GameLobbyController and GameController, timed
+    dispatcher->subscribe(MessageType::GameList, this, [this](const Message& message) {
+        QList<GameInfo> snapshot;
+        if (message.read(snapshot)) {
+            timed(stats->game_list_apply, [&]() { game_list_model->syncGames(snapshot); });
+        }
+    });
+    dispatcher->subscribe(MessageType::GameAdded, this, [this](const Message& message) {
+        GameInfo game;
+        if (message.read(game)) {
+            timed(stats->game_list_apply, [&]() { game_list_model->insertGame(game); });
+        }
+    });
+    dispatcher->subscribe(MessageType::GameRemoved, this, [this](const Message& message) {
+        quint32 game_id = 0;
+        if (message.read(game_id)) {
+            timed(stats->game_list_apply, [&]() { game_list_model->removeGameById(game_id); });
+            if (game_id == joined_game) {
+                joined_game = 0;
+            }
+        }
+    });
+    dispatcher->subscribe(MessageType::GameUpdated, this, [this](const Message& message) {
+        quint32 game_id = 0;
+        qint32 current_players = 0;
+        qint32 spectators = 0;
+        if (message.read(game_id, current_players, spectators)) {
+            timed(stats->game_list_apply,
+                  [&]() { game_list_model->updateCounts(game_id, current_players, spectators); });
+        }
+    });
+    dispatcher->subscribe(MessageType::LobbyChat, this, [this](const Message& message) {
+        QString sender;
+        QString text;
+        if (!message.read(sender, text)) {
+            return;
+        }
+        chat_model->appendMessage(sender, text);
+        if (text.startsWith(QLatin1String(CHAT_PREFIX))) {
+            const qint64 sent_ns = QStringView(text).mid(qstrlen(CHAT_PREFIX)).toLongLong();
+            stats->chat_latency.add((loadClock().nsecsElapsed() - sent_ns) / 1000);
+        }
+    });
+    dispatcher->subscribe(MessageType::TableSnapshot, this, [this](const Message& message) {
+        TableState state;
+        if (TableCodec::decodeSnapshot(message.payload, state)) {
+            timed(stats->table_apply, [&]() { players_model->applySnapshot(state); });
+        }
+    });
+    dispatcher->subscribe(MessageType::TableDelta, this, [this](const Message& message) {
+        TableDelta delta;
+        if (!TableCodec::decodeDelta(message.payload, delta)) {
+            return;
+        }
+        bool applied = false;
+        timed(stats->table_apply, [&]() { applied = players_model->applyDelta(delta); });
+        if (!applied) {
+            connection->send(Message::create(MessageType::TableSnapshotRequest));
+        }
+    });
+}
+
+void SimulatedClient::scheduleAction()
+{
+    // Uniform in [0.5, 1.5) of the interval
+    const int interval = options.action_interval_ms;
+    action_timer->start(interval / 2 + int(random.bounded(qMax(1, interval))));
+}
+
+void SimulatedClient::act()
+{
+    switch (pickAction()) {
+    case Action::Chat:
+        sendChat();
+        break;
+    case Action::JoinGame:
+        joinRandomGame();
+        break;
+    case Action::LeaveGame:
+        leaveGame();
+        break;
+    case Action::HostGame:
+        hostGame();
+        break;
+    case Action::LoadDeck:
+        loadDeck();
+        break;
+    case Action::Idle:
+        break;
+    }
+    scheduleAction();
+}
+
+SimulatedClient::Action SimulatedClient::pickAction()
+{
+    int total = 0;
+    for (int weight : ACTION_WEIGHTS) {
+        total += weight;
+    }
+    int pick = int(random.bounded(total));
+    for (int i = 0; i < int(std::size(ACTION_WEIGHTS)); ++i) {
+        if (pick < ACTION_WEIGHTS[i]) {
+            return static_cast<Action>(i);
+        }
+        pick -= ACTION_WEIGHTS[i];
+    }
+    return Action::Idle;
+}
+
+void SimulatedClient::sendChat()
+{
+    const QString text = QString(CHAT_PREFIX) + QString::number(loadClock().nsecsElapsed());
+    if (connection->sendChat(Message::create(MessageType::LobbyChat, QString(), text))) {
+        ++stats->chat_sent;
+    } else {
+        ++stats->chat_dropped;
+    }
+}
+
+void SimulatedClient::joinRandomGame()
+{
+    const int count = game_list_model->rowCount();
+    if (count == 0) {
+        return;
+    }
+    const QModelIndex index = game_list_model->index(int(random.bounded(count)));
+    const quint32 game_id = game_list_model->data(index, GameListModel::GameIdRole).toUInt();
+    const bool spectator = random.bounded(4) == 0;
+    connection->send(Message::create(MessageType::JoinGame, game_id, spectator));
+    joined_game = game_id;
+    ++stats->games_joined;
+}
+
+void SimulatedClient::leaveGame()
+{
+    if (joined_game == 0) {
+        return;
+    }
+    connection->send(Message::create(MessageType::LeaveGame));
+    joined_game = 0;
+    ++stats->games_left;
+}
+
+void SimulatedClient::hostGame()
+{
+    if (hosting) {
+        return;
+    }
+    GameInfo game;
+    game.name = QString("%1's table").arg(player_name);
+    game.format = "Standard";
+    game.max_players = 5;
+    connection->send(Message::create(MessageType::CreateGame, game));
+    hosting = true;
+    ++stats->games_hosted;
+}
+
+void SimulatedClient::loadDeck()
+{
+    if (options.deck_file.isEmpty() || deck_loader->isLoading()) {
+        return;
+    }
+    deck_timer.start();
+    deck_loader->load(options.deck_file);
+}
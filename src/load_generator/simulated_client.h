@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QString>
+#include "load_stats.h"
+
+class ChatModel;
+class DeckLoader;
+class DeckModel;
+class GameListModel;
+class GamePlayersModel;
+class QTimer;
+class ServerConnection;
+
+/*
+ * One headless client: its own connection plus the models the QML controllers would drive, fed by the same
+ * messages. After login it keeps picking a random action (chat, join, leave or host a game, load a deck) every
+ * action interval, with jitter so the clients of a run do not act in lockstep.
+ */
+class SimulatedClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options
+    {
+        QString host = "127.0.0.1";
+        quint16 port = 4747;
+        int action_interval_ms = 1000;
+        QString deck_file; // Empty skips deck loads
+    };
+
+    SimulatedClient(int index, const Options& options, LoadStats* stats, QObject* parent = nullptr);
+
+    void start();
+    bool isConnected() const;
+    qint64 getAverageRttUs() const;
+
+private:
+    enum class Action {
+        Chat,
+        JoinGame,
+        LeaveGame,
+        HostGame,
+        LoadDeck,
+        Idle,
+    };
+
+    Options options;
+    LoadStats* stats;
+    QString player_name;
+    ServerConnection* connection;
+    GameListModel* game_list_model;
+    ChatModel* chat_model;
+    GamePlayersModel* players_model;
+    DeckModel* deck_model;
+    DeckLoader* deck_loader;
+    QTimer* action_timer;
+    QRandomGenerator random;
+    QElapsedTimer deck_timer;
+    quint32 joined_game = 0;
+    bool hosting = false;
+
+    void subscribe();
+    void scheduleAction();
+    void act();
+    Action pickAction();
+    void sendChat();
+    void joinRandomGame();
+    void leaveGame();
+    void hostGame();
+    void loadDeck();
+};
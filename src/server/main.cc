@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include "stand_in_server.h"
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("SchreckNET stand-in server");
+    app.setApplicationVersion("0.1");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Local stand-in for the SchreckNET server, for development and measurements.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption port_option({"p", "port"}, "TCP port for desktop clients.", "port", "4747");
+    QCommandLineOption websocket_port_option({"w", "websocket-port"}, "WebSocket port for wasm clients, 0 to disable.",
+                                             "port", "4749");
+    QCommandLineOption name_option("name", "Server name sent to clients.", "name", "SchreckNET stand-in server");
+    QCommandLineOption games_option("games", "Number of sample games to list in the lobby.", "count", "5");
+    QCommandLineOption delay_option("delay", "Artificial latency added to every frame sent, in ms.", "ms", "0");
+    parser.addOptions({port_option, websocket_port_option, name_option, games_option, delay_option});
+    parser.process(app);
+
+    StandInServer::Options options;
+    options.port = parser.value(port_option).toUShort();
+    options.websocket_port = parser.value(websocket_port_option).toUShort();
+    options.name = parser.value(name_option);
+    options.delay_ms = parser.value(delay_option).toInt();
+
+    StandInServer server(options);
+    server.addSampleGames(parser.value(games_option).toInt());
+    if (!server.listen()) {
+        return 1;
+    }
+    return app.exec();
+}
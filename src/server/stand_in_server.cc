@@ -0,0 +1,659 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "stand_in_server.h"
+#include <QDebug>
+#include <QHostAddress>
+#include <QPointer>
+#include <QRandomGenerator>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QWebSocket>
+#include <QWebSocketServer>
+
+namespace {
+
+constexpr int STATS_INTERVAL_MS = 10000;
+constexpr int TABLE_TICK_MS = 50;
+constexpr int STARTING_POOL = 30;
+constexpr quint32 SUPPORTED_FEATURES = CompressionFeature;
+
+// Replies to the connection itself carry no event sequence and are not replayed on resume
+bool isEvent(MessageType type)
+{
+    switch (type) {
+    case MessageType::Welcome:
+    case MessageType::Error:
+    case MessageType::Pong:
+    case MessageType::Resumed:
+    case MessageType::ResumeRejected:
+        return false;
+    default:
+        return true;
+    }
+}
+
+} // namespace
+
+StandInServer::StandInServer(const Options& options, QObject* parent)
+    : QObject(parent)
+    , options(options)
+    , tcp_server(new QTcpServer(this))
+    , stats_timer(new QTimer(this))
+    , table_timer(new QTimer(this))
+{
+    connect(tcp_server, &QTcpServer::newConnection, this, &StandInServer::onTcpConnection);
+
+    if (options.websocket_port != 0) {
+        websocket_server = new QWebSocketServer(options.name, QWebSocketServer::NonSecureMode, this);
+        connect(websocket_server, &QWebSocketServer::newConnection, this, &StandInServer::onWebSocketConnection);
+    }
+
+    stats_timer->setInterval(STATS_INTERVAL_MS);
+    connect(stats_timer, &QTimer::timeout, this, &StandInServer::printStats);
+    table_timer->setInterval(TABLE_TICK_MS);
+    connect(table_timer, &QTimer::timeout, this, &StandInServer::sendTableDeltas);
+}
+
+bool StandInServer::listen()
+{
+    if (!tcp_server->listen(QHostAddress::Any, options.port)) {
+        qWarning() << "Cannot listen on TCP port" << options.port << ":" << tcp_server->errorString();
+        return false;
+    }
+    qInfo() << "Listening for TCP clients on port" << tcp_server->serverPort();
+
+    if (websocket_server) {
+        if (!websocket_server->listen(QHostAddress::Any, options.websocket_port)) {
+            qWarning() << "Cannot listen on WebSocket port" << options.websocket_port << ":"
+                       << websocket_server->errorString();
+            return false;
+        }
+        qInfo() << "Listening for WebSocket clients on port" << websocket_server->serverPort();
+    }
+
+    clock.start();
+    stats_clock.start();
+    stats_timer->start();
+    table_timer->start();
+    return true;
+}
+
+void StandInServer::addSampleGames(int count)
+{
+    static const char* const FORMATS[] = {"Standard", "Rated Regular", "Casual Dual", "Legacy"};
+    for (int i = 0; i < count; ++i) {
+        GameInfo game;
+        game.id = next_game_id++;
+        game.name = QString("Sample Game %1").arg(game.id);
+        game.host = QString("Bot%1").arg(i % 97);
+        game.format = FORMATS[i % 4];
+        game.current_players = 1 + i % 4;
+        game.max_players = 5;
+        game.spectators = i % 3;
+        games.insert(game.id, game);
+    }
+}
+
+void StandInServer::onTcpConnection()
+{
+    while (QTcpSocket* socket = tcp_server->nextPendingConnection()) {
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        QSharedPointer<Session> session = addSession(socket);
+        const QPointer<QTcpSocket> guarded(socket);
+        session->write = [guarded](const QByteArray& bytes) {
+            if (guarded) {
+                guarded->write(bytes);
+            }
+        };
+        session->close = [guarded]() {
+            if (guarded) {
+                guarded->disconnectFromHost();
+            }
+        };
+
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReceived(socket, socket->readAll()); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            removeSession(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void StandInServer::onWebSocketConnection()
+{
+    while (QWebSocket* socket = websocket_server->nextPendingConnection()) {
+        QSharedPointer<Session> session = addSession(socket);
+        const QPointer<QWebSocket> guarded(socket);
+        session->write = [guarded](const QByteArray& bytes) {
+            if (guarded) {
+                guarded->sendBinaryMessage(bytes);
+            }
+        };
+        session->close = [guarded]() {
+            if (guarded) {
+                guarded->close();
+            }
+        };
+
+        connect(socket, &QWebSocket::binaryMessageReceived, this,
+                [this, socket](const QByteArray& bytes) { onReceived(socket, bytes); });
+        connect(socket, &QWebSocket::disconnected, this, [this, socket]() {
+            removeSession(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+QSharedPointer<StandInServer::Session> StandInServer::addSession(QObject* socket)
+{
+    QSharedPointer<Session> session(new Session);
+    session->id = next_session_id++;
+    session->socket = socket;
+    sessions.insert(socket, session);
+    qInfo() << "Session" << session->id << "connected," << sessions.size() << "open";
+    return session;
+}
+
+void StandInServer::removeSession(QObject* socket)
+{
+    const QSharedPointer<Session> session = sessions.take(socket);
+    if (!session) {
+        return;
+    }
+    qInfo() << "Session" << session->id << session->player_name << "disconnected," << sessions.size() << "open";
+    if (!session->logged_in) {
+        return;
+    }
+
+    // Keep seat, games and events until the client resumes or the grace period ends
+    session->socket = nullptr;
+    const int detach_count = ++session->detach_count;
+    detached_sessions.insert(session->id, session);
+    QTimer::singleShot(RESUME_GRACE_MS, this, [this, id = session->id, detach_count]() {
+        expireSession(id, detach_count);
+    });
+}
+
+void StandInServer::expireSession(quint32 session_id, int detach_count)
+{
+    const auto it = detached_sessions.constFind(session_id);
+    // Resumed, possibly dropped again since; a later timer takes care of that
+    if (it == detached_sessions.constEnd() || it.value()->detach_count != detach_count) {
+        return;
+    }
+    const QSharedPointer<Session> session = it.value();
+    detached_sessions.erase(it);
+    qInfo() << "Session" << session->id << session->player_name << "expired";
+    leaveTable(*session);
+    removeGamesOf(session->id);
+}
+
+void StandInServer::resumeSession(Session& session, const Message& message)
+{
+    quint16 version = 0;
+    quint32 session_id = 0;
+    QByteArray token;
+    quint32 last_event = 0;
+    if (!message.read(version, session_id, token, last_event) || version != PROTOCOL_VERSION) {
+        send(session, Message::create(MessageType::Error, QString("Unsupported protocol version %1.").arg(version)));
+        session.close();
+        return;
+    }
+
+    QSharedPointer<Session> previous = detached_sessions.value(session_id);
+    if (!previous) {
+        // The client noticed the drop before we did, its old connection is still open
+        for (auto it = sessions.cbegin(); it != sessions.cend(); ++it) {
+            if (it.value()->id == session_id && it.key() != session.socket && it.value()->logged_in) {
+                previous = it.value();
+                break;
+            }
+        }
+    }
+    if (!previous || previous->resume_token != token || last_event < previous->replay_evicted_through) {
+        send(session, Message::create(MessageType::ResumeRejected));
+        return;
+    }
+
+    if (previous->socket) {
+        sessions.remove(previous->socket);
+        previous->close();
+    }
+    detached_sessions.remove(session_id);
+
+    // The session moves onto the new connection
+    previous->socket = session.socket;
+    previous->write = session.write;
+    previous->close = session.close;
+    previous->codec.clear();
+    sessions.insert(session.socket, previous);
+
+    QList<Message> missed;
+    for (const Message& event : std::as_const(previous->replay)) {
+        if (event.sequence > last_event) {
+            missed.append(event);
+        }
+    }
+    send(*previous, Message::create(MessageType::Resumed, quint32(missed.size())));
+    for (const Message& event : std::as_const(missed)) {
+        writeFrame(*previous, event);
+    }
+    qInfo() << "Session" << previous->id << previous->player_name << "resumed," << missed.size() << "events replayed";
+}
+
+void StandInServer::onReceived(QObject* socket, const QByteArray& bytes)
+{
+    // Keep the session alive while its handlers run, a broadcast may close sockets
+    const QSharedPointer<Session> session = sessions.value(socket);
+    if (!session) {
+        return;
+    }
+
+    bytes_in += bytes.size();
+    session->codec.append(bytes);
+    Message message;
+    while (session->codec.next(message)) {
+        ++messages_in;
+        if (!PayloadCompression::decompress(message, &compression)) {
+            qWarning() << "Session" << session->id << "sent a corrupt compressed frame, closing";
+            session->close();
+            return;
+        }
+        handleMessage(*session, message);
+    }
+    if (session->codec.hasError()) {
+        qWarning() << "Session" << session->id << "sent a corrupt frame, closing";
+        session->close();
+    }
+}
+
+void StandInServer::handleMessage(Session& session, const Message& message)
+{
+    // Pings are answered before login, the client's server prober measures with them
+    if (!session.logged_in && message.type != MessageType::Hello && message.type != MessageType::Resume
+        && message.type != MessageType::Ping) {
+        send(session, Message::create(MessageType::Error, QString("Not logged in.")));
+        session.close();
+        return;
+    }
+
+    switch (message.type) {
+    case MessageType::Hello: {
+        quint16 version = 0;
+        QString password;
+        quint32 features = 0;
+        if (!message.read(version, session.player_name, password, features) || version != PROTOCOL_VERSION) {
+            send(session, Message::create(MessageType::Error,
+                                          QString("Unsupported protocol version %1.").arg(version)));
+            session.close();
+            return;
+        }
+        session.logged_in = true;
+        session.features = features & SUPPORTED_FEATURES;
+        session.resume_token.clear();
+        for (int i = 0; i < 4; ++i) {
+            const quint32 word = QRandomGenerator::system()->generate();
+            session.resume_token.append(reinterpret_cast<const char*>(&word), sizeof(word));
+        }
+        send(session, Message::create(MessageType::Welcome, session.id, options.name, session.resume_token,
+                                      session.features));
+        send(session, Message::create(MessageType::GameList, games.values()));
+        qInfo() << "Session" << session.id << "logged in as" << session.player_name;
+        break;
+    }
+    case MessageType::Resume:
+        if (!session.logged_in) {
+            resumeSession(session, message);
+        }
+        break;
+    case MessageType::GameListRequest:
+        send(session, Message::create(MessageType::GameList, games.values()));
+        break;
+    case MessageType::CreateGame: {
+        GameInfo game;
+        if (message.read(game)) {
+            createGame(session, game);
+        }
+        break;
+    }
+    case MessageType::JoinGame: {
+        quint32 game_id = 0;
+        bool spectator = false;
+        if (message.read(game_id, spectator)) {
+            joinGame(session, game_id, spectator);
+        }
+        break;
+    }
+    case MessageType::LeaveGame:
+        leaveTable(session);
+        break;
+    case MessageType::TurnCommand: {
+        quint8 action = 0;
+        if (message.read(action) && action < static_cast<quint8>(TurnAction::Count)) {
+            applyTurnAction(session, static_cast<TurnAction>(action));
+        }
+        break;
+    }
+    case MessageType::TableSnapshotRequest:
+        if (tables.contains(session.game_id)) {
+            const TableState& state = tables[session.game_id].sent;
+            send(session, Message{MessageType::TableSnapshot, 0, TableCodec::encodeSnapshot(state)});
+        }
+        break;
+    case MessageType::ActionLogRequest: {
+        quint32 index = 0;
+        const auto it = tables.constFind(session.game_id);
+        if (it != tables.constEnd() && message.read(index)) {
+            // Only the missing actions when the client's log still lines up, else from the latest snapshot
+            QByteArray tail = it->log.encodeSince(index);
+            if (tail.isEmpty()) {
+                tail = it->log.encodeFromSnapshot();
+            }
+            send(session, Message{MessageType::ActionLogTail, 0, tail});
+        }
+        break;
+    }
+    case MessageType::PlayerStatusChange: {
+        quint8 status = 0;
+        if (message.read(status) && status < static_cast<quint8>(PlayerStatus::Count)) {
+            setPlayerStatus(session, static_cast<PlayerStatus>(status));
+        }
+        break;
+    }
+    case MessageType::Ping:
+        send(session, Message{MessageType::Pong, 0, message.payload});
+        break;
+    case MessageType::Pong:
+        break;
+    case MessageType::LobbyChat: {
+        QString sender;
+        QString text;
+        if (!session.chat_bucket.tryTake(clock.elapsed())) {
+            ++chat_dropped;
+        } else if (message.read(sender, text)) {
+            broadcast(Message::create(MessageType::LobbyChat, session.player_name, text));
+        }
+        break;
+    }
+    case MessageType::GameChat: {
+        QString game;
+        QString sender;
+        QString text;
+        if (!session.chat_bucket.tryTake(clock.elapsed())) {
+            ++chat_dropped;
+        } else if (message.read(game, sender, text)) {
+            broadcast(Message::create(MessageType::GameChat, game, session.player_name, text));
+        }
+        break;
+    }
+    default:
+        qDebug() << "Session" << session.id << "sent unhandled message type" << static_cast<int>(message.type);
+        break;
+    }
+}
+
+void StandInServer::send(Session& session, Message message)
+{
+    if (isEvent(message.type)) {
+        message.sequence = session.next_sequence++;
+        session.replay.enqueue(message);
+        if (session.replay.size() > REPLAY_LIMIT) {
+            session.replay_evicted_through = session.replay.dequeue().sequence;
+        }
+    }
+    writeFrame(session, message);
+}
+
+void StandInServer::writeFrame(Session& session, Message message)
+{
+    // Replayed events are kept uncompressed and compressed again when written
+    if (session.features & CompressionFeature) {
+        PayloadCompression::compress(message, &compression);
+    }
+    const QByteArray frame = FrameCodec::encode(message);
+    ++messages_out;
+    bytes_out += frame.size();
+    if (options.delay_ms > 0) {
+        // Timers of equal interval fire in order, so frames keep their order
+        QTimer::singleShot(options.delay_ms, this, [write = session.write, frame]() { write(frame); });
+    } else {
+        session.write(frame);
+    }
+}
+
+void StandInServer::broadcast(const Message& message)
+{
+    for (const QSharedPointer<Session>& session : loggedInSessions()) {
+        send(*session, message);
+    }
+}
+
+QList<QSharedPointer<StandInServer::Session>> StandInServer::loggedInSessions() const
+{
+    // Detached sessions still collect their events, for the replay when they resume
+    QList<QSharedPointer<Session>> list = detached_sessions.values();
+    list.reserve(list.size() + sessions.size());
+    for (const QSharedPointer<Session>& session : sessions) {
+        if (session->logged_in) {
+            list.append(session);
+        }
+    }
+    return list;
+}
+
+void StandInServer::createGame(Session& session, GameInfo game)
+{
+    leaveTable(session);
+
+    game.id = next_game_id++;
+    game.host = session.player_name;
+    game.current_players = 1;
+    game.spectators = 0;
+    games.insert(game.id, game);
+    game_hosts.insert(game.id, session.id);
+    broadcast(Message::create(MessageType::GameAdded, game));
+
+    // The host takes the first seat
+    session.spectator = false;
+    GamePlayer host;
+    host.id = session.id;
+    host.name = session.player_name;
+    host.life = STARTING_POOL;
+    host.is_host = true;
+    GameState state = tables[game.id].log.head();
+    state.table.players.append(host);
+    session.game_id = game.id;
+    sendTableSnapshot(game.id, state);
+}
+
+void StandInServer::joinGame(Session& session, quint32 game_id, bool spectator)
+{
+    const auto it = games.constFind(game_id);
+    if (it == games.constEnd() || session.game_id == game_id
+        || (!spectator && it->current_players >= it->max_players)) {
+        return;
+    }
+
+    leaveTable(session);
+    GameInfo& game = games[game_id];
+    if (spectator) {
+        ++game.spectators;
+    } else {
+        ++game.current_players;
+    }
+    broadcast(Message::create(MessageType::GameUpdated, game_id, qint32(game.current_players), qint32(game.spectators)));
+
+    session.game_id = game_id;
+    session.spectator = spectator;
+    GameState state = tables[game_id].log.head();
+    if (!spectator) {
+        GamePlayer player;
+        player.id = session.id;
+        player.name = session.player_name;
+        player.life = STARTING_POOL;
+        state.table.players.append(player);
+    }
+    // Membership changes are not actions or deltas, everyone at the table gets a new snapshot
+    sendTableSnapshot(game_id, state);
+}
+
+void StandInServer::leaveTable(Session& session)
+{
+    const quint32 game_id = session.game_id;
+    session.game_id = 0;
+
+    auto game = games.find(game_id);
+    if (game != games.end()) {
+        if (session.spectator) {
+            game->spectators = qMax(0, game->spectators - 1);
+        } else {
+            game->current_players = qMax(0, game->current_players - 1);
+        }
+        broadcast(Message::create(MessageType::GameUpdated, game_id, qint32(game->current_players),
+                                  qint32(game->spectators)));
+    }
+
+    auto it = tables.find(game_id);
+    if (it == tables.end()) {
+        return;
+    }
+    GameState state = it->log.head();
+    const int seat = GameRules::seatOf(state.table, session.id);
+    if (seat < 0) {
+        return;
+    }
+    // The turn state refers to seats, it has to follow the players moving down
+    state.table.players.removeAt(seat);
+    TurnMachine::removeSeat(state.turn, seat);
+    sendTableSnapshot(game_id, state);
+}
+
+void StandInServer::setPlayerStatus(Session& session, PlayerStatus status)
+{
+    // The status goes out with the next table delta, an oust ends the turn right away
+    appendAction(session.game_id, GameAction::status(session.id, status));
+}
+
+void StandInServer::applyTurnAction(Session& session, TurnAction action)
+{
+    // Only the host starts the game; GameRules checks the rest the same way the client does
+    if (action == TurnAction::StartGame && game_hosts.value(session.game_id) != session.id) {
+        return;
+    }
+    if (!appendAction(session.game_id, GameAction::turn(session.id, action))) {
+        return;
+    }
+
+    if (action == TurnAction::StartGame) {
+        Table& table = tables[session.game_id];
+        table.deck_seed = QRandomGenerator::global()->generate64();
+        sendToTable(session.game_id, Message::create(MessageType::DeckSeed, table.deck_seed));
+    }
+}
+
+bool StandInServer::appendAction(quint32 game_id, const GameAction& action)
+{
+    auto it = tables.find(game_id);
+    if (it == tables.end()) {
+        return false;
+    }
+    const TurnState before = it->log.head().turn;
+    if (!it->log.append(action)) {
+        return false;
+    }
+
+    sendToTable(game_id, Message::create(MessageType::GameActionEvent, it->log.endIndex() - 1, action.pack()));
+    if (it->log.head().turn != before) {
+        sendToTable(game_id, Message::create(MessageType::TurnChanged, it->log.head().turn));
+    }
+    return true;
+}
+
+void StandInServer::sendTableSnapshot(quint32 game_id, GameState state)
+{
+    // A player joining a running game takes the next seat; leaving players were taken out by leaveTable
+    TurnState& turn = state.turn;
+    if (turn.isStarted()) {
+        turn.seat_count = quint8(qMin<qsizetype>(state.table.players.size(), TurnState::MAX_SEATS));
+        if (turn.seat_count == 0) {
+            turn = TurnState();
+        }
+    }
+
+    Table& table = tables[game_id];
+    table.log.checkpoint(state);
+    const quint32 sequence = table.sent.sequence + 1;
+    table.sent = state.table;
+    table.sent.sequence = sequence;
+    const Message message{MessageType::TableSnapshot, 0, TableCodec::encodeSnapshot(table.sent)};
+    table_bytes += message.payload.size();
+    sendToTable(game_id, message);
+    sendToTable(game_id, Message::create(MessageType::TurnChanged, turn));
+    // Starts the members' logs over at the checkpoint
+    sendToTable(game_id, Message{MessageType::ActionLogTail, 0, table.log.encodeFromSnapshot()});
+    if (turn.isStarted()) {
+        // Players already dealt ignore a seed they have
+        sendToTable(game_id, Message::create(MessageType::DeckSeed, table.deck_seed));
+    }
+}
+
+void StandInServer::sendTableDeltas()
+{
+    for (auto it = tables.begin(); it != tables.end(); ++it) {
+        // All changes since the last tick share one sequence number
+        TableState current = it->log.head().table;
+        current.sequence = it->sent.sequence + 1;
+        const TableDelta delta = TableCodec::diff(it->sent, current);
+        if (delta.changes.isEmpty()) {
+            continue;
+        }
+        it->sent = current;
+
+        const Message message{MessageType::TableDelta, 0, TableCodec::encodeDelta(delta)};
+        table_bytes += message.payload.size();
+        sendToTable(it.key(), message);
+    }
+}
+
+void StandInServer::sendToTable(quint32 game_id, const Message& message)
+{
+    for (const QSharedPointer<Session>& session : loggedInSessions()) {
+        if (session->game_id == game_id) {
+            send(*session, message);
+        }
+    }
+}
+
+void StandInServer::removeGamesOf(quint32 session_id)
+{
+    for (auto it = game_hosts.begin(); it != game_hosts.end();) {
+        if (it.value() == session_id) {
+            games.remove(it.key());
+            tables.remove(it.key());
+            broadcast(Message::create(MessageType::GameRemoved, it.key()));
+            it = game_hosts.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void StandInServer::printStats()
+{
+    if (messages_in == 0 && messages_out == 0) {
+        return;
+    }
+    const double seconds = stats_clock.restart() / 1000.0;
+    qInfo().nospace() << sessions.size() << " sessions, in " << messages_in / seconds << " msg/s ("
+                      << bytes_in / seconds / 1024 << " KiB/s), out " << messages_out / seconds << " msg/s ("
+                      << bytes_out / seconds / 1024 << " KiB/s), " << chat_dropped << " chat messages dropped, "
+                      << table_bytes << " bytes of table state, " << compression.frames
+                      << " payloads compressed " << compression.ratio() << ":1 in " << compression.cpu_ns / 1000000.0
+                      << " ms";
+    messages_in = messages_out = bytes_in = bytes_out = chat_dropped = table_bytes = 0;
+    compression = PayloadCompression::Stats();
+}
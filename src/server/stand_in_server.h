@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020-2025, Stolas <schrecknet@codeinject.org>
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QString>
+#include <functional>
+#include "action_log.h"
+#include "frame_codec.h"
+#include "game_info.h"
+#include "message.h"
+#include "payload_compression.h"
+#include "table_state.h"
+#include "token_bucket.h"
+#include "turn_state.h"
+
+class QTcpServer;
+class QTimer;
+class QWebSocketServer;
+
+/*
+ * Minimal local server speaking the client protocol, so the client can be run and measured on one machine.
+ * Accepts TCP (desktop clients) and WebSocket (wasm clients) connections, answers the handshake and pings and
+ * broadcasts chat and game table changes. Sessions whose connection drops are kept for a grace period, so the
+ * client can resume them and get the events it missed replayed. It keeps no persistent state.
+ */
+class StandInServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options
+    {
+        quint16 port = 4747;
+        quint16 websocket_port = 4749; // 0 disables the WebSocket listener
+        QString name = "SchreckNET stand-in server";
+        int delay_ms = 0; // Artificial latency added to every frame sent
+    };
+
+    // Events kept per session for replay on resume, and how long a dropped session can be resumed
+    static constexpr int REPLAY_LIMIT = 1024;
+    static constexpr int RESUME_GRACE_MS = 30000;
+
+    explicit StandInServer(const Options& options, QObject* parent = nullptr);
+
+    // Seeds the lobby with a number of games, to measure the client with large game lists
+    void addSampleGames(int count);
+
+    bool listen();
+
+private:
+    struct Session
+    {
+        quint32 id = 0;
+        QObject* socket = nullptr;
+        QString player_name;
+        bool logged_in = false;
+        quint32 features = 0; // Agreed on at login
+        quint32 next_sequence = 1;
+        quint32 game_id = 0; // Game joined as player or spectator, 0 for the lobby
+        bool spectator = false;
+        FrameCodec codec;
+        // Server side of the chat flow control, a little more lenient than the client's own limit
+        TokenBucket chat_bucket{3.0, 8.0};
+        std::function<void(const QByteArray&)> write;
+        std::function<void()> close;
+
+        // Session resume
+        QByteArray resume_token;
+        QQueue<Message> replay;             // Last events sent, oldest first
+        quint32 replay_evicted_through = 0; // Highest event sequence dropped from the replay queue
+        int detach_count = 0;
+    };
+
+    Options options;
+    QTcpServer* tcp_server;
+    QWebSocketServer* websocket_server = nullptr;
+    QTimer* stats_timer;
+    QTimer* table_timer;
+    QHash<QObject*, QSharedPointer<Session>> sessions;
+    // Logged in sessions whose connection dropped, by session id, until resumed or expired
+    QHash<quint32, QSharedPointer<Session>> detached_sessions;
+    quint32 next_session_id = 1;
+
+    // Open games by id, with the session hosting them
+    QHash<quint32, GameInfo> games;
+    QHash<quint32, quint32> game_hosts;
+    quint32 next_game_id = 1;
+
+    // Table of every game joined at least once. The log head is the current state; its changes are collected
+    // and sent as one delta per tick
+    struct Table
+    {
+        ActionLog log;
+        TableState sent; // State the members were last sent, its sequence is the table's
+        quint64 deck_seed = 0; // Drawn when the game starts
+    };
+    QHash<quint32, Table> tables;
+
+    // Traffic since the last stats line
+    QElapsedTimer stats_clock;
+    quint64 messages_in = 0;
+    quint64 messages_out = 0;
+    quint64 bytes_in = 0;
+    quint64 bytes_out = 0;
+    quint64 chat_dropped = 0;
+    quint64 table_bytes = 0;
+    PayloadCompression::Stats compression;
+    QElapsedTimer clock;
+
+    void onTcpConnection();
+    void onWebSocketConnection();
+    QSharedPointer<Session> addSession(QObject* socket);
+    void removeSession(QObject* socket);
+    void expireSession(quint32 session_id, int detach_count);
+    void resumeSession(Session& session, const Message& message);
+    QList<QSharedPointer<Session>> loggedInSessions() const;
+    void onReceived(QObject* socket, const QByteArray& bytes);
+    void handleMessage(Session& session, const Message& message);
+    void send(Session& session, Message message);
+    void writeFrame(Session& session, Message message);
+    void broadcast(const Message& message);
+    void createGame(Session& session, GameInfo game);
+    void joinGame(Session& session, quint32 game_id, bool spectator);
+    void leaveTable(Session& session);
+    void setPlayerStatus(Session& session, PlayerStatus status);
+    void applyTurnAction(Session& session, TurnAction action);
+    bool appendAction(quint32 game_id, const GameAction& action);
+    void sendTableSnapshot(quint32 game_id, GameState state);
+    void sendTableDeltas();
+    void sendToTable(quint32 game_id, const Message& message);
+    void removeGamesOf(quint32 session_id);
+    void printStats();
+};